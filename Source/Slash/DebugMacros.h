@@ -1,21 +0,0 @@
-#pragma once
-
-#include "CoreMinimal.h"
-
-#define DRAW_SPHERE(Location) if (GetWorld()) { DrawDebugSphere(GetWorld(), Location, 25, 12, FColor::Blue, true, 60.f, .25); }
-#define DRAW_SPHERE_COLOR(Location, Color) if (GetWorld()) { DrawDebugSphere(GetWorld(), Location, 8, 12, Color, false, 5.f, .25); }
-#define DRAW_SPHERE_SingleFrame(Location) if (GetWorld()) { DrawDebugSphere(GetWorld(), Location, 25, 12, FColor::Blue, false, -1.f); }
-#define DRAW_POINT_SingleFrame(Location) if (GetWorld()) { DrawDebugPoint(GetWorld(), Location, 15.f, FColor::Red, false, -1.f, 0); }
-#define DRAW_POINT(Location) if (GetWorld()) { DrawDebugPoint(GetWorld(), Location, 15.f, FColor::Red, true, -1.f, 0); }
-#define DRAW_VECTOR(StartLocation, EndLocation) \
-if (GetWorld()) \
-{ \
-	DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Red, true, -1.f, 0, 1.f); \
-	DrawDebugPoint(GetWorld(), EndLocation, 15.f, FColor::Red, true, -1.f, 0); \
-}
-#define DRAW_VECTOR_SingleFrame(StartLocation, EndLocation) \
-if (GetWorld()) \
-{ \
-	DrawDebugLine(GetWorld(), StartLocation, EndLocation, FColor::Red, false, -1.f, 0, 1.f); \
-	DrawDebugPoint(GetWorld(), EndLocation, 15.f, FColor::Red, false, -1.f, 0); \
-}
\ No newline at end of file
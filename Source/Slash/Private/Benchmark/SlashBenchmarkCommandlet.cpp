@@ -0,0 +1,703 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Benchmark/SlashBenchmarkCommandlet.h"
+#include "Breakable/BreakableActor.h"
+#include "Characters/SlashCharacter.h"
+#include "Enemy/Enemy.h"
+#include "Interfaces/HitInterface.h"
+#include "Items/Treasure.h"
+#include "Pooling/ActorPoolSubsystem.h"
+#include "Random/SlashRandomSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/DamageType.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "NavigationSystem.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashStats.h"
+
+namespace
+{
+	/** Which enemy movement Slash.AI.LightweightMovement is pinned to; Compare runs Full then Lightweight. */
+	enum class EBenchmarkMovement : uint8
+	{
+		Default,
+		Full,
+		Lightweight,
+		Compare
+	};
+
+	struct FBenchmarkSettings
+	{
+		FString MapName;
+		FString OutputPath;
+		int32 NumEnemies = 100;
+		int32 NumProps = 50;
+		int32 NumPatrolPoints = 4;
+		int32 NumFrames = 1800;
+		int32 NumWarmupFrames = 60;
+		int32 Seed = 1;
+		float DeltaTime = 1.f / 60.f;
+		float Extent = 8000.f;
+
+		/** Without the stand-in nothing engages the enemies, so they patrol for the whole run. */
+		bool bPatrolOnly = false;
+		EBenchmarkMovement Movement = EBenchmarkMovement::Default;
+
+		/** The stand-in walks a loop of this radius around the arena centre at PlayerSpeed. */
+		float PlayerLoopRadius = 2000.f;
+		float PlayerSpeed = 450.f;
+
+		/** Seconds between the stand-in's sword strikes on the nearest enemy, and how hard and far they reach. */
+		float StrikeInterval = 0.6f;
+		float StrikeDamage = 20.f;
+		float StrikeRange = 250.f;
+
+		/** Seconds between the stand-in smashing a random remaining prop. */
+		float BreakInterval = 1.f;
+
+		UClass* EnemyClass = nullptr;
+		UClass* PlayerClass = nullptr;
+		UClass* BreakableClass = nullptr;
+		UClass* TreasureClass = nullptr;
+	};
+
+	struct FBenchmarkCounters
+	{
+		int32 ActorsSpawned = 0;
+		int32 ActorsDestroyed = 0;
+		int32 PoolHits = 0;
+		int32 PoolMisses = 0;
+		TMap<FString, int32> SpawnedByClass;
+		TMap<FString, int32> DestroyedByClass;
+
+		/** Live enemies by movement mode at the end of the run. */
+		int32 EnemiesWalking = 0;
+		int32 EnemiesNavWalking = 0;
+		int32 EnemiesFalling = 0;
+
+		/** Live enemies still patrolling at the end of the run, and how many of them got anywhere. */
+		int32 EnemiesPatrolling = 0;
+		int32 PatrollersMoved = 0;
+	};
+
+	/** How far a patroller must have got from where it spawned to count as having walked its route. */
+	constexpr double MinPatrolDistance = 100.0;
+
+	template<typename T>
+	UClass* ParseClass(const TCHAR* Params, const TCHAR* Key)
+	{
+		FString ClassPath;
+		if (FParse::Value(Params, Key, ClassPath))
+		{
+			if (UClass* Class = LoadClass<T>(nullptr, *ClassPath))
+			{
+				return Class;
+			}
+			UE_LOG(LogSlash, Warning, TEXT("SlashBenchmark: could not load %s%s, using %s"), Key, *ClassPath, *T::StaticClass()->GetName());
+		}
+		return T::StaticClass();
+	}
+
+	FBenchmarkSettings ParseSettings(const FString& Params)
+	{
+		FBenchmarkSettings Settings;
+		FParse::Value(*Params, TEXT("Map="), Settings.MapName);
+		FParse::Value(*Params, TEXT("Enemies="), Settings.NumEnemies);
+		FParse::Value(*Params, TEXT("Props="), Settings.NumProps);
+		FParse::Value(*Params, TEXT("PatrolPoints="), Settings.NumPatrolPoints);
+		FParse::Value(*Params, TEXT("Frames="), Settings.NumFrames);
+		FParse::Value(*Params, TEXT("WarmupFrames="), Settings.NumWarmupFrames);
+		FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+		FParse::Value(*Params, TEXT("DeltaTime="), Settings.DeltaTime);
+		FParse::Value(*Params, TEXT("Extent="), Settings.Extent);
+		Settings.bPatrolOnly = FParse::Param(*Params, TEXT("PatrolOnly"));
+
+		FString Movement;
+		if (FParse::Value(*Params, TEXT("Movement="), Movement))
+		{
+			if (Movement == TEXT("Full")) Settings.Movement = EBenchmarkMovement::Full;
+			else if (Movement == TEXT("Lightweight")) Settings.Movement = EBenchmarkMovement::Lightweight;
+			else if (Movement == TEXT("Compare")) Settings.Movement = EBenchmarkMovement::Compare;
+			else UE_LOG(LogSlash, Warning, TEXT("SlashBenchmark: unknown -Movement=%s, expected Full, Lightweight or Compare"), *Movement);
+		}
+
+		Settings.NumEnemies = FMath::Max(0, Settings.NumEnemies);
+		Settings.NumProps = FMath::Max(0, Settings.NumProps);
+		Settings.NumPatrolPoints = FMath::Max(1, Settings.NumPatrolPoints);
+		Settings.NumFrames = FMath::Max(1, Settings.NumFrames);
+		Settings.NumWarmupFrames = FMath::Max(0, Settings.NumWarmupFrames);
+		Settings.DeltaTime = FMath::Max(KINDA_SMALL_NUMBER, Settings.DeltaTime);
+		Settings.PlayerLoopRadius = FMath::Min(Settings.PlayerLoopRadius, Settings.Extent * 0.5f);
+
+		if (!FParse::Value(*Params, TEXT("Output="), Settings.OutputPath))
+		{
+			Settings.OutputPath = FPaths::ProjectSavedDir() / TEXT("Benchmark") / FString::Printf(TEXT("SlashBenchmark-%s.json"), *FDateTime::Now().ToString());
+		}
+		Settings.OutputPath = FPaths::ConvertRelativePathToFull(Settings.OutputPath);
+
+		Settings.EnemyClass = ParseClass<AEnemy>(*Params, TEXT("EnemyClass="));
+		Settings.PlayerClass = ParseClass<ASlashCharacter>(*Params, TEXT("PlayerClass="));
+		Settings.BreakableClass = ParseClass<ABreakableActor>(*Params, TEXT("BreakableClass="));
+		Settings.TreasureClass = ParseClass<ATreasure>(*Params, TEXT("TreasureClass="));
+		return Settings;
+	}
+
+	UWorld* CreateBenchmarkWorld(const FString& MapName)
+	{
+		UPackage* Package = LoadPackage(nullptr, *MapName, LOAD_None);
+		UWorld* World = Package ? UWorld::FindWorldInPackage(Package) : nullptr;
+		if (World == nullptr) return nullptr;
+
+		World->WorldType = EWorldType::Game;
+		World->AddToRoot();
+		if (!World->bIsWorldInitialized)
+		{
+			World->InitWorld(UWorld::InitializationValues().AllowAudioPlayback(false));
+		}
+
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		const FURL URL;
+		World->SetGameMode(URL);
+		World->CreateAISystem();
+		World->InitializeActorsForPlay(URL);
+		World->BeginPlay();
+		return World;
+	}
+
+	void DestroyBenchmarkWorld(UWorld* World)
+	{
+		World->BeginTearingDown();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		World->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	bool HasNavMesh(UWorld* World)
+	{
+		const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		return NavSys && NavSys->GetDefaultNavDataInstance(FNavigationSystem::DontCreate) != nullptr;
+	}
+
+	/** Drops Location onto the navmesh at any height in the map, then lifts it by HeightAboveFloor; unchanged if nothing is below. */
+	FVector ProjectToFloor(UWorld* World, const FVector& Location, float HeightAboveFloor)
+	{
+		FNavLocation NavLocation;
+		const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+		if (NavSys && NavSys->ProjectPointToNavigation(Location, NavLocation, FVector(500.f, 500.f, 100000.f)))
+		{
+			return NavLocation.Location + FVector(0.f, 0.f, HeightAboveFloor);
+		}
+		return Location;
+	}
+
+	FVector RandomArenaLocation(UWorld* World, FRandomStream& Random, float Extent, float HeightAboveFloor)
+	{
+		return ProjectToFloor(World, FVector(Random.FRandRange(-Extent, Extent), Random.FRandRange(-Extent, Extent), 0.f), HeightAboveFloor);
+	}
+
+	ASlashCharacter* SpawnStandIn(UWorld* World, const FBenchmarkSettings& Settings)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+		const FVector Start = ProjectToFloor(World, FVector(Settings.PlayerLoopRadius, 0.f, 0.f), 100.f);
+		ASlashCharacter* Player = World->SpawnActor<ASlashCharacter>(Settings.PlayerClass, Start, FRotator::ZeroRotator, SpawnParams);
+		if (Player == nullptr) return nullptr;
+
+		// A controller without a local player: the AI director and significance treat it as the viewer, nothing reads input
+		if (APlayerController* Controller = World->SpawnActor<APlayerController>(APlayerController::StaticClass(), SpawnParams))
+		{
+			Controller->Possess(Player);
+		}
+		return Player;
+	}
+
+	void SpawnEnemies(UWorld* World, const FBenchmarkSettings& Settings, FRandomStream& Random, TMap<TWeakObjectPtr<AEnemy>, FVector>& OutSpawnLocations)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		TArray<AActor*> PatrolTargets;
+		for (int32 EnemyIndex = 0; EnemyIndex < Settings.NumEnemies; ++EnemyIndex)
+		{
+			const FVector Home = RandomArenaLocation(World, Random, Settings.Extent, 100.f);
+
+			PatrolTargets.Reset();
+			for (int32 PointIndex = 0; PointIndex < Settings.NumPatrolPoints; ++PointIndex)
+			{
+				const FVector Offset(Random.FRandRange(-1000.f, 1000.f), Random.FRandRange(-1000.f, 1000.f), 0.f);
+				PatrolTargets.Add(World->SpawnActor<ATargetPoint>(ATargetPoint::StaticClass(), ProjectToFloor(World, Home + Offset, 0.f), FRotator::ZeroRotator, SpawnParams));
+			}
+
+			const FTransform Transform(FRotator(0.f, Random.FRandRange(0.f, 360.f), 0.f), Home);
+			AEnemy* Enemy = World->SpawnActorDeferred<AEnemy>(Settings.EnemyClass, Transform, nullptr, nullptr, SpawnParams.SpawnCollisionHandlingOverride);
+			if (Enemy == nullptr) continue;
+
+			Enemy->AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
+			Enemy->SetPatrolTargets(PatrolTargets);
+			Enemy->FinishSpawning(Transform);
+			OutSpawnLocations.Add(Enemy, Enemy->GetActorLocation());
+		}
+	}
+
+	void SpawnProps(UWorld* World, const FBenchmarkSettings& Settings, FRandomStream& Random, TArray<TWeakObjectPtr<AActor>>& OutBreakables)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		for (int32 PropIndex = 0; PropIndex < Settings.NumProps; ++PropIndex)
+		{
+			// Two breakables to every loose treasure, roughly what the levels have
+			const bool bTreasure = PropIndex % 3 == 2;
+			UClass* Class = bTreasure ? Settings.TreasureClass : Settings.BreakableClass;
+			const FVector Location = RandomArenaLocation(World, Random, Settings.Extent, 50.f);
+			AActor* Prop = World->SpawnActor(Class, &Location, &FRotator::ZeroRotator, SpawnParams);
+			if (Prop && !bTreasure)
+			{
+				OutBreakables.Add(Prop);
+			}
+		}
+	}
+
+	/** Walks the stand-in around its loop and swings at whatever is in reach, the way a player would. */
+	struct FStandInScript
+	{
+		ASlashCharacter* Player = nullptr;
+		TArray<TWeakObjectPtr<AActor>> Breakables;
+		double NextStrikeTime = 0.0;
+		double NextBreakTime = 0.0;
+
+		void Step(UWorld* World, const FBenchmarkSettings& Settings, FRandomStream& Random)
+		{
+			if (Player == nullptr || Player->IsActorBeingDestroyed()) return;
+
+			const double Now = World->GetTimeSeconds();
+			const double Angle = Now * Settings.PlayerSpeed / Settings.PlayerLoopRadius;
+			const FVector Location(FMath::Cos(Angle) * Settings.PlayerLoopRadius, FMath::Sin(Angle) * Settings.PlayerLoopRadius, Player->GetActorLocation().Z);
+			const FRotator Facing(0.f, FMath::RadiansToDegrees(Angle) + 90.f, 0.f);
+			Player->SetActorLocationAndRotation(Location, Facing, true);
+
+			if (Now >= NextStrikeTime)
+			{
+				NextStrikeTime = Now + Settings.StrikeInterval;
+				StrikeNearestEnemy(World, Settings);
+			}
+			if (Now >= NextBreakTime)
+			{
+				NextBreakTime = Now + Settings.BreakInterval;
+				BreakRandomProp(Random);
+			}
+		}
+
+		void StrikeNearestEnemy(UWorld* World, const FBenchmarkSettings& Settings)
+		{
+			AEnemy* Nearest = nullptr;
+			double NearestDistSquared = FMath::Square(Settings.StrikeRange);
+			for (TActorIterator<AEnemy> It(World); It; ++It)
+			{
+				if (It->IsDead()) continue;
+
+				const double DistSquared = FVector::DistSquared(It->GetActorLocation(), Player->GetActorLocation());
+				if (DistSquared < NearestDistSquared)
+				{
+					Nearest = *It;
+					NearestDistSquared = DistSquared;
+				}
+			}
+			if (Nearest == nullptr) return;
+
+			UGameplayStatics::ApplyDamage(Nearest, Settings.StrikeDamage, Player->GetController(), Player, UDamageType::StaticClass());
+			IHitInterface::Execute_GetHit(Nearest, Nearest->GetActorLocation(), Player);
+		}
+
+		void BreakRandomProp(FRandomStream& Random)
+		{
+			Breakables.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Breakable) { return !Breakable.IsValid(); });
+			if (Breakables.Num() == 0) return;
+
+			const int32 Index = Random.RandHelper(Breakables.Num());
+			AActor* Breakable = Breakables[Index].Get();
+			Breakables.RemoveAtSwap(Index);
+			IHitInterface::Execute_GetHit(Breakable, Breakable->GetActorLocation(), Player);
+		}
+	};
+
+	double Percentile(const TArray<double>& Sorted, double Fraction)
+	{
+		if (Sorted.Num() == 0) return 0.0;
+
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+		return Sorted[Index];
+	}
+
+	void GetPoolTotals(UWorld* World, int32& OutHits, int32& OutMisses)
+	{
+		OutHits = 0;
+		OutMisses = 0;
+		if (const UActorPoolSubsystem* Pool = World->GetSubsystem<UActorPoolSubsystem>())
+		{
+			for (const TPair<UClass*, FActorPoolBucket>& Pair : Pool->GetBuckets())
+			{
+				OutHits += Pair.Value.Hits;
+				OutMisses += Pair.Value.Misses;
+			}
+		}
+	}
+
+	TSharedRef<FJsonObject> CountsToJson(const TMap<FString, int32>& Counts)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		for (const TPair<FString, int32>& Pair : Counts)
+		{
+			Object->SetNumberField(Pair.Key, Pair.Value);
+		}
+		return Object;
+	}
+
+	bool WriteReport(const FBenchmarkSettings& Settings, const TArray<double>& FrameTimesMs, const FBenchmarkCounters& Counters, uint64 PeakUsedPhysicalDuringRun)
+	{
+		TArray<double> Sorted = FrameTimesMs;
+		Sorted.Sort();
+
+		double TotalMs = 0.0;
+		for (const double FrameMs : FrameTimesMs)
+		{
+			TotalMs += FrameMs;
+		}
+		const int32 NumFrames = FrameTimesMs.Num();
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("Timestamp"), FDateTime::UtcNow().ToIso8601());
+		Root->SetStringField(TEXT("BuildVersion"), FApp::GetBuildVersion());
+		Root->SetStringField(TEXT("BuildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+		Root->SetStringField(TEXT("Map"), Settings.MapName);
+		Root->SetNumberField(TEXT("Enemies"), Settings.NumEnemies);
+		Root->SetNumberField(TEXT("Props"), Settings.NumProps);
+		Root->SetNumberField(TEXT("Frames"), NumFrames);
+		Root->SetNumberField(TEXT("DeltaTime"), Settings.DeltaTime);
+		Root->SetNumberField(TEXT("Seed"), Settings.Seed);
+		Root->SetBoolField(TEXT("PatrolOnly"), Settings.bPatrolOnly);
+		Root->SetStringField(TEXT("Movement"),
+			Settings.Movement == EBenchmarkMovement::Full ? TEXT("Full") :
+			Settings.Movement == EBenchmarkMovement::Lightweight ? TEXT("Lightweight") : TEXT("Default"));
+
+		TSharedRef<FJsonObject> FrameTime = MakeShared<FJsonObject>();
+		FrameTime->SetNumberField(TEXT("Mean"), NumFrames > 0 ? TotalMs / NumFrames : 0.0);
+		FrameTime->SetNumberField(TEXT("P50"), Percentile(Sorted, 0.5));
+		FrameTime->SetNumberField(TEXT("P90"), Percentile(Sorted, 0.9));
+		FrameTime->SetNumberField(TEXT("P95"), Percentile(Sorted, 0.95));
+		FrameTime->SetNumberField(TEXT("P99"), Percentile(Sorted, 0.99));
+		FrameTime->SetNumberField(TEXT("Max"), Sorted.Num() > 0 ? Sorted.Last() : 0.0);
+		Root->SetObjectField(TEXT("FrameTimeMs"), FrameTime);
+
+		// Mean exclusive game-thread ms per frame for every SLASH_SCOPE_TIMER; whatever is left is engine work
+		TSharedRef<FJsonObject> Subsystems = MakeShared<FJsonObject>();
+		double ScopedMs = 0.0;
+		for (const TPair<FName, uint64>& Pair : FSlashScopeTimings::GetTotals())
+		{
+			const double Ms = FPlatformTime::ToMilliseconds64(Pair.Value);
+			ScopedMs += Ms;
+			Subsystems->SetNumberField(Pair.Key.ToString(), NumFrames > 0 ? Ms / NumFrames : 0.0);
+		}
+		Subsystems->SetNumberField(TEXT("Unattributed"), NumFrames > 0 ? FMath::Max(0.0, TotalMs - ScopedMs) / NumFrames : 0.0);
+		Root->SetObjectField(TEXT("GameThreadMsPerFrame"), Subsystems);
+
+		TSharedRef<FJsonObject> Actors = MakeShared<FJsonObject>();
+		Actors->SetNumberField(TEXT("Spawned"), Counters.ActorsSpawned);
+		Actors->SetNumberField(TEXT("Destroyed"), Counters.ActorsDestroyed);
+		Actors->SetNumberField(TEXT("PoolHits"), Counters.PoolHits);
+		Actors->SetNumberField(TEXT("PoolMisses"), Counters.PoolMisses);
+		Actors->SetObjectField(TEXT("SpawnedByClass"), CountsToJson(Counters.SpawnedByClass));
+		Actors->SetObjectField(TEXT("DestroyedByClass"), CountsToJson(Counters.DestroyedByClass));
+		Root->SetObjectField(TEXT("Actors"), Actors);
+
+		TSharedRef<FJsonObject> MovementModes = MakeShared<FJsonObject>();
+		MovementModes->SetNumberField(TEXT("Walking"), Counters.EnemiesWalking);
+		MovementModes->SetNumberField(TEXT("NavWalking"), Counters.EnemiesNavWalking);
+		MovementModes->SetNumberField(TEXT("Falling"), Counters.EnemiesFalling);
+		Root->SetObjectField(TEXT("EnemyMovementModes"), MovementModes);
+
+		TSharedRef<FJsonObject> Patrol = MakeShared<FJsonObject>();
+		Patrol->SetNumberField(TEXT("Patrolling"), Counters.EnemiesPatrolling);
+		Patrol->SetNumberField(TEXT("Moved"), Counters.PatrollersMoved);
+		Root->SetObjectField(TEXT("EnemyPatrol"), Patrol);
+
+		const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+		Memory->SetNumberField(TEXT("PeakUsedPhysicalMB"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+		Memory->SetNumberField(TEXT("PeakUsedVirtualMB"), MemoryStats.PeakUsedVirtual / (1024.0 * 1024.0));
+		Memory->SetNumberField(TEXT("PeakUsedPhysicalDuringRunMB"), PeakUsedPhysicalDuringRun / (1024.0 * 1024.0));
+		Root->SetObjectField(TEXT("Memory"), Memory);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		if (!FJsonSerializer::Serialize(Root, Writer) || !FFileHelper::SaveStringToFile(Json, *Settings.OutputPath))
+		{
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: failed to write %s"), *Settings.OutputPath);
+			return false;
+		}
+
+		// Per-frame times next to the summary, for plotting spikes
+		FString Csv = TEXT("Frame,FrameMs\n");
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			Csv += FString::Printf(TEXT("%d,%.4f\n"), Frame, FrameTimesMs[Frame]);
+		}
+		const FString CsvPath = FPaths::ChangeExtension(Settings.OutputPath, TEXT("csv"));
+		if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+		{
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: failed to write %s"), *CsvPath);
+			return false;
+		}
+
+		UE_LOG(LogSlash, Display, TEXT("SlashBenchmark: %d enemies, %d frames: mean %.3f ms, p50 %.3f ms, p99 %.3f ms, max %.3f ms -> %s"),
+			Settings.NumEnemies, NumFrames, NumFrames > 0 ? TotalMs / NumFrames : 0.0, Percentile(Sorted, 0.5), Percentile(Sorted, 0.99),
+			Sorted.Num() > 0 ? Sorted.Last() : 0.0, *Settings.OutputPath);
+		return true;
+	}
+
+	/** Pins Slash.AI.LightweightMovement for one run and puts the previous value back afterwards. */
+	struct FScopedMovementPin
+	{
+		IConsoleVariable* LightweightMovement = nullptr;
+		int32 PreviousValue = 0;
+
+		explicit FScopedMovementPin(EBenchmarkMovement Movement)
+		{
+			if (Movement == EBenchmarkMovement::Default) return;
+
+			LightweightMovement = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.AI.LightweightMovement"));
+			if (LightweightMovement == nullptr) return;
+
+			// 2 rather than 1 so the result doesn't depend on which enemies the significance pass happens to cull
+			PreviousValue = LightweightMovement->GetInt();
+			LightweightMovement->Set(Movement == EBenchmarkMovement::Lightweight ? 2 : 0, ECVF_SetByCode);
+		}
+
+		~FScopedMovementPin()
+		{
+			if (LightweightMovement)
+			{
+				LightweightMovement->Set(PreviousValue, ECVF_SetByCode);
+			}
+		}
+	};
+
+	void CountEnemyMovementModes(UWorld* World, FBenchmarkCounters& Counters)
+	{
+		for (TActorIterator<AEnemy> It(World); It; ++It)
+		{
+			const UCharacterMovementComponent* Movement = It->GetCharacterMovement();
+			if (It->IsDead() || Movement == nullptr) continue;
+
+			Counters.EnemiesWalking += Movement->MovementMode == MOVE_Walking;
+			Counters.EnemiesNavWalking += Movement->MovementMode == MOVE_NavWalking;
+			Counters.EnemiesFalling += Movement->MovementMode == MOVE_Falling;
+		}
+	}
+
+	/** Movement modes alone don't show an enemy standing still on the navmesh, so compare against where each one spawned. */
+	void CountPatrollersMoved(const TMap<TWeakObjectPtr<AEnemy>, FVector>& SpawnLocations, FBenchmarkCounters& Counters)
+	{
+		for (const TPair<TWeakObjectPtr<AEnemy>, FVector>& Pair : SpawnLocations)
+		{
+			const AEnemy* Enemy = Pair.Key.Get();
+			if (Enemy == nullptr || Enemy->GetEnemyState() != EEnemyState::EES_Patrolling) continue;
+
+			++Counters.EnemiesPatrolling;
+			Counters.PatrollersMoved += FVector::Dist2D(Enemy->GetActorLocation(), Pair.Value) >= MinPatrolDistance;
+		}
+	}
+
+	/** A mode comparison is only meaningful if each run actually ran the mode it claims to, and the patrols actually walked. */
+	bool CheckMovementModes(const FBenchmarkSettings& Settings, const FBenchmarkCounters& Counters)
+	{
+		if (Settings.Movement == EBenchmarkMovement::Lightweight && Counters.EnemiesNavWalking == 0)
+		{
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: no enemy entered navmesh walking (%d walking, %d falling); check the map's floor and navmesh"),
+				Counters.EnemiesWalking, Counters.EnemiesFalling);
+			return false;
+		}
+		if (Settings.Movement == EBenchmarkMovement::Full && Counters.EnemiesNavWalking > 0)
+		{
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: %d enemies used navmesh walking in a full-movement run"), Counters.EnemiesNavWalking);
+			return false;
+		}
+		if (Counters.PatrollersMoved * 2 < Counters.EnemiesPatrolling)
+		{
+			// Patrol waits are seconds long, but every patroller starts walking at BeginPlay
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: only %d of %d patrolling enemies moved %.0f units from their spawn; check path requests and the navmesh"),
+				Counters.PatrollersMoved, Counters.EnemiesPatrolling, MinPatrolDistance);
+			return false;
+		}
+		return true;
+	}
+
+	/** One full scenario in a fresh world; returns the mean frame time, or a negative value on failure. */
+	double RunBenchmark(const FBenchmarkSettings& Settings)
+	{
+		FRandomStream Random(Settings.Seed);
+		const FScopedMovementPin MovementPin(Settings.Movement);
+
+		UWorld* World = CreateBenchmarkWorld(Settings.MapName);
+		if (World == nullptr)
+		{
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: could not load map %s"), *Settings.MapName);
+			return -1.0;
+		}
+		if (!HasNavMesh(World))
+		{
+			// Without one nothing stands on a floor or paths anywhere, and the frame times say nothing about gameplay
+			UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: %s has no navmesh; build navigation for the arena first"), *Settings.MapName);
+			DestroyBenchmarkWorld(World);
+			return -1.0;
+		}
+
+		// Gameplay streams were seeded when the world came up; pin them so every run makes the same choices
+		if (USlashRandomSubsystem* GameplayRandom = World->GetSubsystem<USlashRandomSubsystem>())
+		{
+			GameplayRandom->Reseed(Settings.Seed);
+		}
+
+		FStandInScript StandIn;
+		if (!Settings.bPatrolOnly)
+		{
+			StandIn.Player = SpawnStandIn(World, Settings);
+		}
+		TMap<TWeakObjectPtr<AEnemy>, FVector> EnemySpawnLocations;
+		SpawnEnemies(World, Settings, Random, EnemySpawnLocations);
+		SpawnProps(World, Settings, Random, StandIn.Breakables);
+
+		FBenchmarkCounters Counters;
+		bool bMeasuring = false;
+		const FDelegateHandle SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda(
+			[&Counters, &bMeasuring](AActor* Actor)
+			{
+				if (!bMeasuring) return;
+				++Counters.ActorsSpawned;
+				++Counters.SpawnedByClass.FindOrAdd(Actor->GetClass()->GetName());
+			}));
+		const FDelegateHandle DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateLambda(
+			[&Counters, &bMeasuring](AActor* Actor)
+			{
+				if (!bMeasuring) return;
+				++Counters.ActorsDestroyed;
+				++Counters.DestroyedByClass.FindOrAdd(Actor->GetClass()->GetName());
+			}));
+
+		TArray<double> FrameTimesMs;
+		FrameTimesMs.Reserve(Settings.NumFrames);
+		uint64 PeakUsedPhysical = 0;
+		int32 PoolHitsAtStart = 0;
+		int32 PoolMissesAtStart = 0;
+
+		for (int32 Frame = 0; Frame < Settings.NumWarmupFrames + Settings.NumFrames; ++Frame)
+		{
+			if (Frame == Settings.NumWarmupFrames)
+			{
+				bMeasuring = true;
+				GetPoolTotals(World, PoolHitsAtStart, PoolMissesAtStart);
+				FSlashScopeTimings::BeginCapture();
+			}
+
+			// Scripted input stands in for the player's frame and isn't part of the measured time
+			StandIn.Step(World, Settings, Random);
+
+			FApp::SetDeltaTime(Settings.DeltaTime);
+			FApp::SetCurrentTime(FApp::GetCurrentTime() + Settings.DeltaTime);
+
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			World->Tick(LEVELTICK_All, Settings.DeltaTime);
+			GEngine->ConditionalCollectGarbage();
+			const uint64 FrameCycles = FPlatformTime::Cycles64() - StartCycles;
+			++GFrameCounter;
+
+			if (bMeasuring)
+			{
+				FrameTimesMs.Add(FPlatformTime::ToMilliseconds64(FrameCycles));
+				PeakUsedPhysical = FMath::Max<uint64>(PeakUsedPhysical, FPlatformMemory::GetStats().UsedPhysical);
+			}
+		}
+
+		FSlashScopeTimings::EndCapture();
+		bMeasuring = false;
+
+		int32 PoolHits = 0;
+		int32 PoolMisses = 0;
+		GetPoolTotals(World, PoolHits, PoolMisses);
+		Counters.PoolHits = PoolHits - PoolHitsAtStart;
+		Counters.PoolMisses = PoolMisses - PoolMissesAtStart;
+		CountEnemyMovementModes(World, Counters);
+		CountPatrollersMoved(EnemySpawnLocations, Counters);
+
+		World->RemoveOnActorSpawnedHandler(SpawnedHandle);
+		World->RemoveOnActorDestroyedHandler(DestroyedHandle);
+
+		const bool bWritten = WriteReport(Settings, FrameTimesMs, Counters, PeakUsedPhysical);
+		DestroyBenchmarkWorld(World);
+		if (!bWritten || !CheckMovementModes(Settings, Counters)) return -1.0;
+
+		double TotalMs = 0.0;
+		for (const double FrameMs : FrameTimesMs)
+		{
+			TotalMs += FrameMs;
+		}
+		return FrameTimesMs.Num() > 0 ? TotalMs / FrameTimesMs.Num() : 0.0;
+	}
+}
+
+USlashBenchmarkCommandlet::USlashBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USlashBenchmarkCommandlet::Main(const FString& Params)
+{
+	const FBenchmarkSettings Settings = ParseSettings(Params);
+	if (Settings.MapName.IsEmpty())
+	{
+		UE_LOG(LogSlash, Error, TEXT("SlashBenchmark: -Map= is required; use a map with floor and navmesh covering +-Extent around the origin"));
+		return 1;
+	}
+	if (Settings.Movement != EBenchmarkMovement::Compare)
+	{
+		return RunBenchmark(Settings) >= 0.0 ? 0 : 1;
+	}
+
+	// Same seed and scenario twice, one report per movement mode next to the requested output
+	FBenchmarkSettings FullSettings = Settings;
+	FullSettings.Movement = EBenchmarkMovement::Full;
+	FullSettings.OutputPath = FPaths::GetPath(Settings.OutputPath) / FPaths::GetBaseFilename(Settings.OutputPath) + TEXT("-Full.json");
+
+	FBenchmarkSettings LightweightSettings = Settings;
+	LightweightSettings.Movement = EBenchmarkMovement::Lightweight;
+	LightweightSettings.OutputPath = FPaths::GetPath(Settings.OutputPath) / FPaths::GetBaseFilename(Settings.OutputPath) + TEXT("-Lightweight.json");
+
+	const double FullMs = RunBenchmark(FullSettings);
+	const double LightweightMs = RunBenchmark(LightweightSettings);
+	if (FullMs < 0.0 || LightweightMs < 0.0) return 1;
+
+	UE_LOG(LogSlash, Display, TEXT("SlashBenchmark: %d enemies, full movement %.3f ms, lightweight movement %.3f ms (%.2fx)"),
+		Settings.NumEnemies, FullMs, LightweightMs, LightweightMs > 0.0 ? FullMs / LightweightMs : 0.0);
+	return 0;
+}
@@ -7,6 +7,8 @@
 #include "GeometryCollection/GeometryCollectionObject.h"
 #include "Items/Treasure.h"
 #include "Components/CapsuleComponent.h"
+#include "Pooling/ActorPoolSubsystem.h"
+#include "Random/SlashRandomSubsystem.h"
 
 ABreakableActor::ABreakableActor()
 {
@@ -27,6 +29,15 @@ ABreakableActor::ABreakableActor()
 void ABreakableActor::BeginPlay()
 {
 	Super::BeginPlay();
+
+	UWorld* World = GetWorld();
+	if (UActorPoolSubsystem* Pool = World ? World->GetSubsystem<UActorPoolSubsystem>() : nullptr)
+	{
+		for (const TSubclassOf<ATreasure>& TreasureClass : TreasureClasses)
+		{
+			Pool->Prewarm(TreasureClass);
+		}
+	}
 }
 
 void ABreakableActor::Tick(float DeltaTime)
@@ -44,8 +55,15 @@ void ABreakableActor::GetHit_Implementation(const FVector& ImpactPoint, AActor*
 		FVector Location = GetActorLocation();
 		Location.Z += 75.f;
 		
-		const int32 Selection = FMath::RandRange(0, TreasureClasses.Num() - 1);
-		World->SpawnActor<ATreasure>(TreasureClasses[Selection], Location, GetActorRotation());
+		const int32 Selection = USlashRandomSubsystem::Get(this, ESlashRandomStream::Loot).RandHelper(TreasureClasses.Num());
+		if (UActorPoolSubsystem* Pool = World->GetSubsystem<UActorPoolSubsystem>())
+		{
+			Pool->Acquire<ATreasure>(TreasureClasses[Selection], Location, GetActorRotation());
+		}
+		else
+		{
+			World->SpawnActor<ATreasure>(TreasureClasses[Selection], Location, GetActorRotation());
+		}
 	}
 	Capsule->DestroyComponent();
 }
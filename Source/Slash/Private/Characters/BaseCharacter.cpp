@@ -4,13 +4,18 @@
 #include "Items/Weapon.h"
 #include "Components/BoxComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/CombatFlagsComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Random/SlashRandomSubsystem.h"
+#include "Slash/SlashDebugDraw.h"
 
-ABaseCharacter::ABaseCharacter()
+ABaseCharacter::ABaseCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = false;
 	Attributes = CreateDefaultSubobject<UAttributeComponent>(TEXT("Attributes"));
+	CombatFlags = CreateDefaultSubobject<UCombatFlagsComponent>(TEXT("CombatFlags"));
 	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 }
 
@@ -41,7 +46,7 @@ void ABaseCharacter::BeginPlay()
 
 void ABaseCharacter::Attack()
 {
-	if (CombatTarget && CombatTarget->ActorHasTag(FName("Dead")))
+	if (UCombatFlagsComponent::ActorHasAnyFlags(CombatTarget, ECombatFlags::ECF_Dead))
 	{
 		CombatTarget = nullptr;
 	}
@@ -61,7 +66,7 @@ int32 ABaseCharacter::PlayRandomMontageSection(UAnimMontage* Montage)
 {
 	if (Montage->GetNumSections() <= 0) return -1;
 	const int32 MaxSectionIndex = Montage->GetNumSections() - 1;
-	const int32 Selection = FMath::RandRange(0, MaxSectionIndex);
+	const int32 Selection = USlashRandomSubsystem::Get(this, ESlashRandomStream::Animation).RandRange(0, MaxSectionIndex);
 	PlayMontageSection(Montage, Montage->GetSectionName(Selection));
 	return Selection;
 }
@@ -145,7 +150,7 @@ void ABaseCharacter::DodgeEnd()
 void ABaseCharacter::Die_Implementation()
 {
 	PlayDeathMontage();
-	Tags.Add(FName("Dead"));
+	CombatFlags->AddFlags(ECombatFlags::ECF_Dead);
 }
 
 void ABaseCharacter::Tick(float DeltaTime)
@@ -173,7 +178,14 @@ void ABaseCharacter::SetWeaponCollisionEnabled(ECollisionEnabled::Type Collissio
 	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
 	{
 		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(CollissionEnabled);
-		EquippedWeapon->IgnoreActors.Empty();
+		if (CollissionEnabled == ECollisionEnabled::NoCollision)
+		{
+			EquippedWeapon->EndSwing();
+		}
+		else
+		{
+			EquippedWeapon->BeginSwing();
+		}
 	}
 }
 
@@ -197,11 +209,10 @@ void ABaseCharacter::DirectionalHitReact(const FVector& ImpactPoint)
 	{
 		AngleOfHit *= -1.f;
 	}
-	/*
-	UKismetSystemLibrary::DrawDebugArrow(this, GetActorLocation(), GetActorLocation() + CrossProduct * 100, 5.f, FColor::Blue, 5.f);
-	UKismetSystemLibrary::DrawDebugArrow(this, GetActorLocation(), GetActorLocation() + GetActorForwardVector() * 60, 5.f, FColor::Red, 5.f);
-	UKismetSystemLibrary::DrawDebugArrow(this, GetActorLocation(), GetActorLocation() + ToHit * 60, 5.f, FColor::Green, 5.f);
-	*/
+	SLASH_DRAW_ARROW(this, HitReact, GetActorLocation(), GetActorLocation() + CrossProduct * 100, FColor::Blue, 5.f);
+	SLASH_DRAW_ARROW(this, HitReact, GetActorLocation(), GetActorLocation() + Forward * 60, FColor::Red, 5.f);
+	SLASH_DRAW_ARROW(this, HitReact, GetActorLocation(), GetActorLocation() + ToHit * 60, FColor::Green, 5.f);
+
 	FName SectionName;
 
 	if (AngleOfHit >= -45.f && AngleOfHit < 45.f)
@@ -2,17 +2,19 @@
 
 #include "Characters/SlashAnimInstance.h"
 #include "Characters/SlashCharacter.h"
+#include "Enemy/Enemy.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "Kismet/KismetMathLibrary.h"
 
 void USlashAnimInstance::NativeInitializeAnimation()
 {
 	Super::NativeInitializeAnimation();
 
-	SlashCharacter = Cast<ASlashCharacter>(TryGetPawnOwner());
-	if (SlashCharacter)
+	Character = Cast<ABaseCharacter>(TryGetPawnOwner());
+	SlashCharacter = Cast<ASlashCharacter>(Character);
+	Enemy = Cast<AEnemy>(Character);
+	if (Character)
 	{
-		SlashCharacterMovement = SlashCharacter->GetCharacterMovement();
+		SlashCharacterMovement = Character->GetCharacterMovement();
 	}
 }
 
@@ -20,12 +22,32 @@ void USlashAnimInstance::NativeUpdateAnimation(float DeltaTime)
 {
 	Super::NativeUpdateAnimation(DeltaTime);
 
+	// Game thread: copy only, so the worker-thread update never touches the character
 	if (SlashCharacterMovement)
 	{
-		GroundSpeed = UKismetMathLibrary::VSizeXY(SlashCharacterMovement->Velocity);
-		IsFalling = SlashCharacterMovement->IsFalling();
-		CharacterState = SlashCharacter->GetCharacterState();
-		ActionState = SlashCharacter->GetActionState();
-		DeathPose = SlashCharacter->GetDeathPose();
+		Snapshot.Velocity = SlashCharacterMovement->Velocity;
+		Snapshot.bIsFalling = SlashCharacterMovement->IsFalling();
+		Snapshot.DeathPose = Character->GetDeathPose();
+		if (SlashCharacter)
+		{
+			Snapshot.CharacterState = SlashCharacter->GetCharacterState();
+			Snapshot.ActionState = SlashCharacter->GetActionState();
+		}
+		else if (Enemy)
+		{
+			Snapshot.EnemyState = Enemy->GetEnemyState();
+		}
 	}
-}
\ No newline at end of file
+}
+
+void USlashAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaTime)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaTime);
+
+	GroundSpeed = Snapshot.Velocity.Size2D();
+	IsFalling = Snapshot.bIsFalling;
+	CharacterState = Snapshot.CharacterState;
+	ActionState = Snapshot.ActionState;
+	EnemyState = Snapshot.EnemyState;
+	DeathPose = Snapshot.DeathPose;
+}
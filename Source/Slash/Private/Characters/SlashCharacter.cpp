@@ -9,7 +9,9 @@
 #include "Camera/CameraComponent.h"
 #include "GroomComponent.h"
 #include "Components/AttributeComponent.h"
+#include "Components/CombatFlagsComponent.h"
 #include "Enemy/Enemy.h"
+#include "Enemy/EnemyPerceptionSubsystem.h"
 #include "TargetSystemComponent.h"
 
 #include "Kismet/KismetMathLibrary.h"
@@ -22,11 +24,13 @@
 #include "EnhancedInputSubsystems.h"
 #include "HUD/SlashHUD.h"
 #include "HUD/SlashOverlay.h"
+#include "Significance/SlashSignificanceSubsystem.h"
 
 
 ASlashCharacter::ASlashCharacter()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Stamina regen is evaluated lazily by UAttributeComponent and the HUD follows its delegates
+	PrimaryActorTick.bCanEverTick = false;
 
 	bUseControllerRotationYaw = false;
 	bUseControllerRotationPitch = false;
@@ -64,34 +68,13 @@ ASlashCharacter::ASlashCharacter()
 	AutoPossessPlayer = EAutoReceiveInput::Player0;
 }
 
-void ASlashCharacter::Tick(float DeltaTime)
-{
-	if (Attributes)
-	{
-		Attributes->RegenStamina(DeltaTime);
-	}
-	if (SlashOverlay)
-	{
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
-	}
-}
-
 float ASlashCharacter::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
 	HandleDamage(DamageAmount);
-	SetHUDHealth();
 	return DamageAmount;
 
 }
 
-void ASlashCharacter::SetHUDHealth()
-{
-	if (SlashOverlay && Attributes)
-	{
-		SlashOverlay->SetHealthBarPercent(Attributes->GetHealthPercent());
-	}
-}
-
 void ASlashCharacter::BeginPlay()
 {
 	Super::BeginPlay();
@@ -106,7 +89,33 @@ void ASlashCharacter::BeginPlay()
 		
 	}
 	InitializeOverlay();
-	Tags.Add(FName("EngageableTarget"));
+	CombatFlags->AddFlags(ECombatFlags::ECF_EngageableTarget);
+
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{
+		Perception->RegisterTarget(this);
+	}
+
+	if (USlashSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<USlashSignificanceSubsystem>())
+	{
+		Significance->Register(Hair, ESignificanceCategory::Groom);
+		Significance->Register(Eyebrows, ESignificanceCategory::Groom);
+	}
+}
+
+void ASlashCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyPerceptionSubsystem* Perception = GetWorld()->GetSubsystem<UEnemyPerceptionSubsystem>())
+	{
+		Perception->UnregisterTarget(this);
+	}
+
+	if (USlashSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<USlashSignificanceSubsystem>())
+	{
+		Significance->Unregister(Hair);
+		Significance->Unregister(Eyebrows);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void ASlashCharacter::InitializeOverlay()
@@ -119,10 +128,7 @@ void ASlashCharacter::InitializeOverlay()
 			SlashOverlay = SlashHUD->GetSlashOverlay();
 			if (SlashOverlay && Attributes)
 			{
-				SlashOverlay->SetHealthBarPercent(Attributes->GetHealthPercent());
-				SlashOverlay->SetStaminaBarPercent(1.f);
-				SlashOverlay->SetCoinCount(0);
-				SlashOverlay->SetSoulsCount(0);
+				SlashOverlay->BindAttributes(Attributes);
 			}
 		}
 	}
@@ -185,10 +191,6 @@ void ASlashCharacter::Dodge(const FInputActionValue& Value)
 	if (!IsUnoccupied() || !Attributes->HasSufficientStamina(StaminaCost)) return;
 	
 	Attributes->UseStamina(StaminaCost);
-	if (SlashOverlay)
-	{
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
-	}
 	PlayDodgeMontage();
 	ActionState = EActionState::EAS_Dodging;	
 }
@@ -377,19 +379,17 @@ void ASlashCharacter::SetOverlappingItem(AItem* Item)
 
 void ASlashCharacter::AddSouls(ASoul* Soul)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
 		Attributes->AddSouls(Soul->GetSouls());
-		SlashOverlay->SetSoulsCount(Attributes->GetSouls());
 	}
 }
 
 void ASlashCharacter::AddGold(ATreasure* Treasure)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
 		Attributes->AddGold(Treasure->GetGold());
-		SlashOverlay->SetCoinCount(Attributes->GetGold());
 	}
 }
 
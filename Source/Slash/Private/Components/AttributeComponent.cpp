@@ -1,6 +1,8 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Components/AttributeComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 
 UAttributeComponent::UAttributeComponent(): Health(0), MaxHealth(0), Stamina(0), MaxStamina(0), Gold(0), Experience(0)
 {
@@ -10,16 +12,65 @@ UAttributeComponent::UAttributeComponent(): Health(0), MaxHealth(0), Stamina(0),
 void UAttributeComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// Start the regen clock (and its completion timer) from the authored value
+	RebaseStamina(Stamina);
 }
 
 void UAttributeComponent::ReceiveDamage(float Damage)
 {
 	Health = FMath::Clamp(Health - Damage, 0.f, MaxHealth);
+	OnHealthChanged.Broadcast(Health, MaxHealth);
 }
 
 void UAttributeComponent::UseStamina(float StaminaCost)
 {
-	Stamina = FMath::Clamp(Stamina - StaminaCost, 0.f, MaxStamina);
+	RebaseStamina(FMath::Clamp(GetStamina() - StaminaCost, 0.f, MaxStamina));
+}
+
+float UAttributeComponent::GetStamina() const
+{
+	if (Stamina >= MaxStamina || StaminaRegenRate <= 0.f) return Stamina;
+
+	const double Elapsed = GetWorldTimeSeconds() - StaminaTimestamp;
+	return FMath::Min(MaxStamina, Stamina + StaminaRegenRate * static_cast<float>(Elapsed));
+}
+
+bool UAttributeComponent::IsRegeneratingStamina() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->GetTimerManager().IsTimerActive(StaminaRegenTimer);
+}
+
+double UAttributeComponent::GetWorldTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void UAttributeComponent::RebaseStamina(float NewStamina)
+{
+	Stamina = NewStamina;
+	StaminaTimestamp = GetWorldTimeSeconds();
+
+	// Nothing runs while stamina fills; a single timer fires at the moment it is full again
+	if (UWorld* World = GetWorld())
+	{
+		if (Stamina < MaxStamina && StaminaRegenRate > 0.f)
+		{
+			World->GetTimerManager().SetTimer(StaminaRegenTimer, this, &UAttributeComponent::OnStaminaRegenComplete, (MaxStamina - Stamina) / StaminaRegenRate);
+		}
+		else
+		{
+			World->GetTimerManager().ClearTimer(StaminaRegenTimer);
+		}
+	}
+	OnStaminaChanged.Broadcast(Stamina, MaxStamina);
+}
+
+void UAttributeComponent::OnStaminaRegenComplete()
+{
+	RebaseStamina(MaxStamina);
 }
 
 float UAttributeComponent::GetHealthPercent()
@@ -27,9 +78,9 @@ float UAttributeComponent::GetHealthPercent()
 	return Health / MaxHealth;
 }
 
-float UAttributeComponent::GetStaminaPercent()
+float UAttributeComponent::GetStaminaPercent() const
 {
-	return Stamina / MaxStamina;
+	return GetStamina() / MaxStamina;
 }
 
 bool UAttributeComponent::IsAlive()
@@ -39,17 +90,19 @@ bool UAttributeComponent::IsAlive()
 
 bool UAttributeComponent::HasSufficientStamina(float StaminaCost)
 {
-	return (Stamina - StaminaCost) >0;
+	return (GetStamina() - StaminaCost) >0;
 }
 
 void UAttributeComponent::AddSouls(int32 NumberOfSouls)
 {
 	Souls += NumberOfSouls;
+	OnSoulsChanged.Broadcast(Souls);
 }
 
 void UAttributeComponent::AddGold(int32 AmountOfGold)
 {
 	Gold += AmountOfGold;
+	OnGoldChanged.Broadcast(Gold);
 }
 
 
@@ -57,8 +110,3 @@ void UAttributeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
-
-void UAttributeComponent::RegenStamina(float DeltaTime)
-{
-	Stamina = FMath::Clamp(Stamina + StaminaRegenRate * DeltaTime, 0.f, MaxStamina);
-}
\ No newline at end of file
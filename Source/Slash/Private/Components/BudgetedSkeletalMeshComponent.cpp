@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Components/BudgetedSkeletalMeshComponent.h"
+#include "Enemy/EnemyAIDirector.h"
+#include "Engine/World.h"
+
+UBudgetedSkeletalMeshComponent::UBudgetedSkeletalMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	// The owning enemy provides significance from its state and significance bucket
+	SetAutoCalculateSignificance(false);
+}
+
+void UBudgetedSkeletalMeshComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	const UWorld* World = GetWorld();
+	AIDirector = World ? World->GetSubsystem<UEnemyAIDirector>() : nullptr;
+}
+
+void UBudgetedSkeletalMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	// Only full evaluations feed the average; interpolated frames are what the budget saves
+	if (AIDirector && PoseTickedThisFrame())
+	{
+		AIDirector->ReportMeshEvaluation(static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles)));
+	}
+}
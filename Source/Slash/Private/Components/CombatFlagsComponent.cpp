@@ -0,0 +1,185 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Components/CombatFlagsComponent.h"
+#include "Characters/BaseCharacter.h"
+#include "Slash/Slash.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+
+namespace SlashTags
+{
+	const FName Enemy(TEXT("Enemy"));
+	const FName Dead(TEXT("Dead"));
+	const FName EngageableTarget(TEXT("EngageableTarget"));
+}
+
+namespace
+{
+	const TPair<ECombatFlags, const FName*> FlagTags[] =
+	{
+		{ ECombatFlags::ECF_Enemy, &SlashTags::Enemy },
+		{ ECombatFlags::ECF_Dead, &SlashTags::Dead },
+		{ ECombatFlags::ECF_EngageableTarget, &SlashTags::EngageableTarget }
+	};
+}
+
+UCombatFlagsComponent::UCombatFlagsComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UCombatFlagsComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Pick up tags authored on the owner (e.g. in a Blueprint) so both views agree from the start
+	if (const AActor* Owner = GetOwner())
+	{
+		for (const TPair<ECombatFlags, const FName*>& FlagTag : FlagTags)
+		{
+			if (Owner->Tags.Contains(*FlagTag.Value))
+			{
+				Flags |= static_cast<uint8>(FlagTag.Key);
+			}
+		}
+	}
+}
+
+void UCombatFlagsComponent::AddFlags(ECombatFlags InFlags)
+{
+	const ECombatFlags Added = InFlags & ~GetFlags();
+	Flags |= static_cast<uint8>(InFlags);
+	SyncOwnerTags(Added, true);
+}
+
+void UCombatFlagsComponent::RemoveFlags(ECombatFlags InFlags)
+{
+	const ECombatFlags Removed = InFlags & GetFlags();
+	Flags &= ~static_cast<uint8>(InFlags);
+	SyncOwnerTags(Removed, false);
+}
+
+void UCombatFlagsComponent::AddCombatFlags(int32 InFlags)
+{
+	AddFlags(static_cast<ECombatFlags>(InFlags));
+}
+
+void UCombatFlagsComponent::RemoveCombatFlags(int32 InFlags)
+{
+	RemoveFlags(static_cast<ECombatFlags>(InFlags));
+}
+
+bool UCombatFlagsComponent::HasAnyCombatFlags(int32 InFlags) const
+{
+	return HasAnyFlags(static_cast<ECombatFlags>(InFlags));
+}
+
+void UCombatFlagsComponent::SyncOwnerTags(ECombatFlags Changed, bool bAdded)
+{
+	AActor* Owner = GetOwner();
+	if (Owner == nullptr || Changed == ECombatFlags::ECF_None) return;
+
+	for (const TPair<ECombatFlags, const FName*>& FlagTag : FlagTags)
+	{
+		if (!EnumHasAnyFlags(Changed, FlagTag.Key)) continue;
+
+		if (bAdded)
+		{
+			Owner->Tags.AddUnique(*FlagTag.Value);
+		}
+		else
+		{
+			Owner->Tags.Remove(*FlagTag.Value);
+		}
+	}
+}
+
+bool UCombatFlagsComponent::ActorHasAnyFlags(const AActor* Actor, ECombatFlags InFlags)
+{
+	if (Actor == nullptr) return false;
+
+	if (const ABaseCharacter* Character = Cast<ABaseCharacter>(Actor))
+	{
+		if (const UCombatFlagsComponent* CombatFlags = Character->GetCombatFlags())
+		{
+			return CombatFlags->HasAnyFlags(InFlags);
+		}
+	}
+
+	for (const TPair<ECombatFlags, const FName*>& FlagTag : FlagTags)
+	{
+		if (EnumHasAnyFlags(InFlags, FlagTag.Key) && Actor->ActorHasTag(*FlagTag.Value))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Slash.Bench.CombatFlags [Iterations]
+ * Times AWeapon's same-faction overlap test with per-call FName tags against the bitmask path,
+ * using the first two characters in the world, or two temporary ones if there aren't enough.
+ */
+static void BenchmarkCombatFlags(const TArray<FString>& Args, UWorld* World)
+{
+	const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000000;
+
+	TArray<ABaseCharacter*, TInlineAllocator<2>> Characters;
+	for (TActorIterator<ABaseCharacter> It(World); It && Characters.Num() < 2; ++It)
+	{
+		Characters.Add(*It);
+	}
+
+	TArray<ABaseCharacter*, TInlineAllocator<2>> Spawned;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	while (Characters.Num() < 2)
+	{
+		ABaseCharacter* Character = World->SpawnActor<ABaseCharacter>(ABaseCharacter::StaticClass(), FTransform::Identity, SpawnParams);
+		if (Character == nullptr || Character->GetCombatFlags() == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.CombatFlags could not spawn a stand-in character"));
+			for (ABaseCharacter* Temporary : Spawned)
+			{
+				Temporary->Destroy();
+			}
+			return;
+		}
+		Character->GetCombatFlags()->AddFlags(ECombatFlags::ECF_Enemy);
+		Characters.Add(Character);
+		Spawned.Add(Character);
+	}
+
+	const AActor* Owner = Characters[0];
+	const AActor* Other = Characters[1];
+	int32 Matches = 0;
+
+	const double TagStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Matches += Owner->ActorHasTag(TEXT("Enemy")) && Other->ActorHasTag(TEXT("Enemy"));
+	}
+	const double TagSeconds = FPlatformTime::Seconds() - TagStart;
+
+	const double FlagStart = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		Matches += UCombatFlagsComponent::ActorHasAnyFlags(Owner, ECombatFlags::ECF_Enemy) && UCombatFlagsComponent::ActorHasAnyFlags(Other, ECombatFlags::ECF_Enemy);
+	}
+	const double FlagSeconds = FPlatformTime::Seconds() - FlagStart;
+
+	UE_LOG(LogSlash, Display, TEXT("CombatFlags %d iterations: tags %.3f ms, flags %.3f ms (%.2fx), %d matches"),
+		Iterations, TagSeconds * 1000.0, FlagSeconds * 1000.0, FlagSeconds > 0.0 ? TagSeconds / FlagSeconds : 0.0, Matches);
+
+	for (ABaseCharacter* Temporary : Spawned)
+	{
+		Temporary->Destroy();
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkCombatFlagsCommand(
+	TEXT("Slash.Bench.CombatFlags"),
+	TEXT("Benchmarks tag-based vs bitmask faction checks. Usage: Slash.Bench.CombatFlags [Iterations]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkCombatFlags));
@@ -0,0 +1,199 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Debug/SlashDebugDrawSubsystem.h"
+#include "Engine/World.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<bool> CVarSlashDebugWeapon(
+	TEXT("Slash.Debug.Weapon"),
+	false,
+	TEXT("Draw weapon blade sweeps (green on hit)."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<bool> CVarSlashDebugAIRanges(
+	TEXT("Slash.Debug.AIRanges"),
+	false,
+	TEXT("Draw enemy combat and attack radii and the current patrol target's acceptance radius."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<bool> CVarSlashDebugPerception(
+	TEXT("Slash.Debug.Perception"),
+	false,
+	TEXT("Draw enemy sight traces (green seen, red blocked)."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<bool> CVarSlashDebugHitReact(
+	TEXT("Slash.Debug.HitReact"),
+	false,
+	TEXT("Draw the facing and hit directions used to pick hit react sections."),
+	ECVF_Cheat);
+
+static TAutoConsoleVariable<int32> CVarSlashDebugMaxLines(
+	TEXT("Slash.Debug.MaxLines"),
+	8192,
+	TEXT("Lines the debug draw buffer holds; anything past this is dropped until older lines expire."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Lines Drawn"), STAT_SlashDebugLinesDrawn, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Lines Dropped"), STAT_SlashDebugLinesDropped, STATGROUP_Slash);
+
+static const TAutoConsoleVariable<bool>* const DebugDrawCVars[] =
+{
+	&CVarSlashDebugWeapon,
+	&CVarSlashDebugAIRanges,
+	&CVarSlashDebugPerception,
+	&CVarSlashDebugHitReact
+};
+static_assert(UE_ARRAY_COUNT(DebugDrawCVars) == static_cast<int32>(ESlashDebugDraw::Num), "Every debug draw category needs a console variable");
+
+bool USlashDebugDrawSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return SLASH_DEBUG_DRAW && Super::ShouldCreateSubsystem(Outer);
+}
+
+void USlashDebugDrawSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USlashDebugDrawSubsystem::Flush);
+}
+
+void USlashDebugDrawSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	Lines.Empty();
+	FrameLines.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USlashDebugDrawSubsystem::IsEnabled(ESlashDebugDraw Category)
+{
+	return DebugDrawCVars[static_cast<int32>(Category)]->GetValueOnGameThread();
+}
+
+USlashDebugDrawSubsystem* USlashDebugDrawSubsystem::Get(const UObject* WorldContext, ESlashDebugDraw Category)
+{
+	if (WorldContext == nullptr || !IsEnabled(Category)) return nullptr;
+
+	const UWorld* World = WorldContext->GetWorld();
+	return World ? World->GetSubsystem<USlashDebugDrawSubsystem>() : nullptr;
+}
+
+void USlashDebugDrawSubsystem::AddLine(const FVector& Start, const FVector& End, const FColor& Color, float Duration)
+{
+	if (Lines.Num() >= CVarSlashDebugMaxLines.GetValueOnGameThread())
+	{
+		++NumDropped;
+		return;
+	}
+	Lines.Emplace(Start, End, Color, Duration, 0.f, SDPG_World);
+}
+
+void USlashDebugDrawSubsystem::AddArrow(const FVector& Start, const FVector& End, const FColor& Color, float Duration)
+{
+	AddLine(Start, End, Color, Duration);
+
+	const FVector Direction = (End - Start).GetSafeNormal();
+	if (Direction.IsZero()) return;
+
+	const double HeadSize = FMath::Min(20.0, FVector::Dist(Start, End) * 0.25);
+	const FVector Side = FVector::CrossProduct(Direction, FMath::Abs(Direction.Z) < 0.99 ? FVector::UpVector : FVector::ForwardVector).GetSafeNormal();
+	AddLine(End, End - Direction * HeadSize + Side * HeadSize * 0.5, Color, Duration);
+	AddLine(End, End - Direction * HeadSize - Side * HeadSize * 0.5, Color, Duration);
+}
+
+void USlashDebugDrawSubsystem::AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color, float Duration)
+{
+	FVector Corners[8];
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		const FVector Local((Index & 1) ? Extent.X : -Extent.X, (Index & 2) ? Extent.Y : -Extent.Y, (Index & 4) ? Extent.Z : -Extent.Z);
+		Corners[Index] = Center + Rotation.RotateVector(Local);
+	}
+
+	// Each edge joins two corners that differ in exactly one axis bit
+	for (int32 Index = 0; Index < 8; ++Index)
+	{
+		for (int32 Bit = 1; Bit < 8; Bit <<= 1)
+		{
+			if ((Index & Bit) == 0)
+			{
+				AddLine(Corners[Index], Corners[Index | Bit], Color, Duration);
+			}
+		}
+	}
+}
+
+void USlashDebugDrawSubsystem::AddCircle(const FVector& Center, float Radius, const FColor& Color, float Duration)
+{
+	constexpr int32 NumSegments = 24;
+	FVector Previous = Center + FVector(Radius, 0.f, 0.f);
+	for (int32 Segment = 1; Segment <= NumSegments; ++Segment)
+	{
+		const float Angle = UE_TWO_PI * Segment / NumSegments;
+		const FVector Next = Center + FVector(FMath::Cos(Angle) * Radius, FMath::Sin(Angle) * Radius, 0.f);
+		AddLine(Previous, Next, Color, Duration);
+		Previous = Next;
+	}
+}
+
+void USlashDebugDrawSubsystem::AddSphere(const FVector& Center, float Radius, const FColor& Color, float Duration)
+{
+	// Three great circles read as a sphere at a fraction of DrawDebugSphere's line count
+	constexpr int32 NumSegments = 16;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		FVector Previous;
+		for (int32 Segment = 0; Segment <= NumSegments; ++Segment)
+		{
+			const float Angle = UE_TWO_PI * Segment / NumSegments;
+			const float Cos = FMath::Cos(Angle) * Radius;
+			const float Sin = FMath::Sin(Angle) * Radius;
+			const FVector Offset = Axis == 0 ? FVector(Cos, Sin, 0.f) : Axis == 1 ? FVector(Cos, 0.f, Sin) : FVector(0.f, Cos, Sin);
+			const FVector Next = Center + Offset;
+			if (Segment > 0)
+			{
+				AddLine(Previous, Next, Color, Duration);
+			}
+			Previous = Next;
+		}
+	}
+}
+
+void USlashDebugDrawSubsystem::AddPoint(const FVector& Location, const FColor& Color, float Duration)
+{
+	constexpr float Size = 8.f;
+	AddLine(Location - FVector(Size, 0.f, 0.f), Location + FVector(Size, 0.f, 0.f), Color, Duration);
+	AddLine(Location - FVector(0.f, Size, 0.f), Location + FVector(0.f, Size, 0.f), Color, Duration);
+	AddLine(Location - FVector(0.f, 0.f, Size), Location + FVector(0.f, 0.f, Size), Color, Duration);
+}
+
+void USlashDebugDrawSubsystem::Flush(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+
+	SET_DWORD_STAT(STAT_SlashDebugLinesDropped, NumDropped);
+	NumDropped = 0;
+	if (Lines.Num() == 0) return;
+
+	if (World->LineBatcher)
+	{
+		FrameLines.Reset();
+		FrameLines.Append(Lines);
+		for (FBatchedLine& Line : FrameLines)
+		{
+			Line.RemainingLifeTime = 0.f;
+		}
+		World->LineBatcher->DrawLines(FrameLines);
+		SET_DWORD_STAT(STAT_SlashDebugLinesDrawn, FrameLines.Num());
+	}
+
+	// Single-frame lines go now; lines with a duration count down and are resubmitted until they expire
+	Lines.RemoveAllSwap([DeltaSeconds](FBatchedLine& Line)
+	{
+		Line.RemainingLifeTime -= DeltaSeconds;
+		return Line.RemainingLifeTime <= 0.f;
+	}, false);
+}
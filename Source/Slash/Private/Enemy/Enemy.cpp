@@ -2,18 +2,44 @@
 
 #include "Enemy/Enemy.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/CapsuleComponent.h"
 #include "Components/AttributeComponent.h"
-#include "HUD/HealthBarComponent.h"
+#include "Components/CombatFlagsComponent.h"
+#include "Components/BudgetedSkeletalMeshComponent.h"
+#include "HUD/HealthBarSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "AIController.h"
 #include "Perception/PawnSensingComponent.h"
 #include "Items/Weapon.h"
 #include "TargetSystemComponent.h"
 #include "Items/Soul.h"
-
-AEnemy::AEnemy()
-{
-	PrimaryActorTick.bCanEverTick = true;
+#include "Enemy/EnemyAIDirector.h"
+#include "Enemy/EnemyPerceptionSubsystem.h"
+#include "Enemy/PatrolRouteSubsystem.h"
+#include "Enemy/EnemyPathSubsystem.h"
+#include "Enemy/EnemyCrowdSubsystem.h"
+#include "Pooling/ActorPoolSubsystem.h"
+#include "Significance/SlashSignificanceSubsystem.h"
+#include "Random/SlashRandomSubsystem.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy UpdateAI"), STAT_SlashEnemyUpdateAI, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Enemy ApplyStateActions"), STAT_SlashEnemyApplyStateActions, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Enemy SpawnSoulsOnDeath"), STAT_SlashEnemySpawnSouls, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemy AI Updates"), STAT_SlashEnemyAIUpdates, STATGROUP_Slash);
+
+static TAutoConsoleVariable<int32> CVarEnemyLightweightMovement(
+	TEXT("Slash.AI.LightweightMovement"),
+	1,
+	TEXT("0 = full character movement always, 1 = navmesh walking for patrolling enemies in the Low or Culled significance buckets, 2 = navmesh walking for every patrolling enemy."),
+	ECVF_Default);
+
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UBudgetedSkeletalMeshComponent>(ACharacter::MeshComponentName))
+	, SignificanceBucket(ESignificanceBucket::High)
+{
+	PrimaryActorTick.bCanEverTick = false;
 
 	GetMesh()->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
 	GetMesh()->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
@@ -21,9 +47,6 @@ AEnemy::AEnemy()
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 	GetMesh()->SetGenerateOverlapEvents(true);
 
-	HealthBarWidget = CreateDefaultSubobject<UHealthBarComponent>(TEXT("HealthBar"));
-	HealthBarWidget->SetupAttachment(GetRootComponent());
-
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	bUseControllerRotationPitch = false;
 	bUseControllerRotationYaw = false;
@@ -32,23 +55,101 @@ AEnemy::AEnemy()
 	PawnSensingComponent = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("Pawn Sensing Component"));
 	PawnSensingComponent->SetPeripheralVisionAngle(65.f);
 	PawnSensingComponent->SightRadius = 10000.f;
+	// Sight settings still live on the component, but sensing itself runs batched in UEnemyPerceptionSubsystem
+	PawnSensingComponent->bEnableSensingUpdates = false;
 }
 
 void AEnemy::BeginPlay()
 {
 	Super::BeginPlay();
-	Tags.Add(FName("Enemy"));
-	if (PawnSensingComponent) PawnSensingComponent->OnSeePawn.AddDynamic(this, &AEnemy::PawnSeen);
+	CombatFlags->AddFlags(ECombatFlags::ECF_Enemy);
 
 	InitializeEnemy();
 }
 
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (AIDirector)
+	{
+		AIDirector->UnregisterEnemy(this);
+		AIDirector = nullptr;
+	}
+	if (Perception)
+	{
+		Perception->UnregisterSensor(this);
+		Perception = nullptr;
+	}
+	if (PathRequests)
+	{
+		PathRequests->CancelMove(this);
+		PathRequests = nullptr;
+	}
+	if (Crowd)
+	{
+		Crowd->RemoveChaser(this);
+		Crowd = nullptr;
+	}
+	if (USlashSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<USlashSignificanceSubsystem>())
+	{
+		Significance->Unregister(GetMesh());
+	}
+	if (HealthBars)
+	{
+		HealthBars->RemoveBar(HealthBarHandle);
+		HealthBars = nullptr;
+		HealthBarHandle = INDEX_NONE;
+	}
+	Super::EndPlay(EndPlayReason);
+}
+
 void AEnemy::InitializeEnemy()
 {
 	EnemyController = Cast<AAIController>(GetController());
+	PathRequests = GetWorld()->GetSubsystem<UEnemyPathSubsystem>();
+	Crowd = GetWorld()->GetSubsystem<UEnemyCrowdSubsystem>();
+	BakePatrolRoute();
 	MoveToTarget(PatrolTarget);
 	HideHealthBar();
 	SpawnDefaultWeapon();
+
+	if (UWorld* World = GetWorld())
+	{
+		AIDirector = World->GetSubsystem<UEnemyAIDirector>();
+		if (AIDirector)
+		{
+			AIDirector->RegisterEnemy(this);
+		}
+
+		Perception = World->GetSubsystem<UEnemyPerceptionSubsystem>();
+		if (Perception && PawnSensingComponent)
+		{
+			Perception->RegisterSensor(this, PawnSensingComponent->SightRadius, PawnSensingComponent->GetPeripheralVisionAngle());
+		}
+
+		if (UActorPoolSubsystem* Pool = World->GetSubsystem<UActorPoolSubsystem>())
+		{
+			Pool->Prewarm(SoulClass);
+		}
+
+		if (USlashSignificanceSubsystem* Significance = World->GetSubsystem<USlashSignificanceSubsystem>())
+		{
+			Significance->Register(GetMesh(), ESignificanceCategory::Enemy);
+		}
+		UpdateMovementMode();
+
+		HealthBars = World->GetSubsystem<UHealthBarSubsystem>();
+		if (HealthBars && HealthBarHandle == INDEX_NONE)
+		{
+			HealthBars->SetBarStyle(HealthBarWidgetClass, HealthBarSize);
+
+			// Starts hidden, like the widget component did, until the enemy takes damage
+			HealthBarHandle = HealthBars->AddBar(this, GetCapsuleComponent()->GetScaledCapsuleHalfHeight() + HealthBarHeight);
+			if (Attributes)
+			{
+				HealthBars->SetBarPercent(HealthBarHandle, Attributes->GetHealthPercent());
+			}
+		}
+	}
 }
 
 void AEnemy::SpawnDefaultWeapon()
@@ -56,9 +157,23 @@ void AEnemy::SpawnDefaultWeapon()
 	UWorld* World = GetWorld();
 	if (World && WeaponClass)
 	{
-		AWeapon* Weapon = World->SpawnActor<AWeapon>(WeaponClass);
-		Weapon->Equip(GetMesh(), FName("WeaponSocket"), this, this);
-		EquippedWeapon = Weapon;
+		// Spawning with an owner puts the weapon straight into the equipped state, skipping its ember effect
+		AWeapon* Weapon = nullptr;
+		if (UActorPoolSubsystem* Pool = World->GetSubsystem<UActorPoolSubsystem>())
+		{
+			Weapon = Pool->Acquire<AWeapon>(WeaponClass, GetActorLocation(), GetActorRotation(), this);
+		}
+		else
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.Owner = this;
+			Weapon = World->SpawnActor<AWeapon>(WeaponClass, GetActorTransform(), SpawnParams);
+		}
+		if (Weapon)
+		{
+			Weapon->Equip(GetMesh(), FName("WeaponSocket"), this, this);
+			EquippedWeapon = Weapon;
+		}
 	}
 }
 
@@ -67,13 +182,29 @@ void AEnemy::Attack()
 	Super::Attack();
 	if (CombatTarget == nullptr) return;
 
-	EnemyState = EEnemyState::EES_Engaged;
+	SetEnemyState(EEnemyState::EES_Engaged);
 	PlayAttackMontage();
 }
 
 void AEnemy::Die_Implementation()
 {
-	EnemyState = EEnemyState::EES_Dead;
+	SetEnemyState(EEnemyState::EES_Dead);
+	if (AIDirector)
+	{
+		AIDirector->UnregisterEnemy(this);
+	}
+	if (Perception)
+	{
+		Perception->UnregisterSensor(this);
+	}
+	if (PathRequests)
+	{
+		PathRequests->CancelMove(this);
+	}
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+	}
 	DisableCapsule();
 	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
 
@@ -96,13 +227,18 @@ void AEnemy::Die_Implementation()
 
 void AEnemy::SpawnSoulsOnDeath()
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashEnemySpawnSouls);
 	UWorld* World = GetWorld();
 	if (World && SoulClass && Attributes)
 	{
 		FVector SpawnLocation = GetActorLocation();
 		SpawnLocation.Z += 125.f;
 
-		if(ASoul* SpawnedSoul = World->SpawnActor<ASoul>(SoulClass, SpawnLocation, GetActorRotation()))
+		UActorPoolSubsystem* Pool = World->GetSubsystem<UActorPoolSubsystem>();
+		ASoul* SpawnedSoul = Pool
+			? Pool->Acquire<ASoul>(SoulClass, SpawnLocation, GetActorRotation(), this)
+			: World->SpawnActor<ASoul>(SoulClass, SpawnLocation, GetActorRotation());
+		if (SpawnedSoul)
 		{
 			SpawnedSoul->SetSouls(Attributes->GetSouls());
 			SpawnedSoul->SetOwner(this);
@@ -110,6 +246,105 @@ void AEnemy::SpawnSoulsOnDeath()
 	}
 }
 
+void AEnemy::DrawDebugRanges() const
+{
+	const FVector Location = GetActorLocation();
+	SLASH_DRAW_CIRCLE(this, AIRanges, Location, CombatRadius, FColor::Yellow);
+	SLASH_DRAW_CIRCLE(this, AIRanges, Location, AttackRadius, FColor::Red);
+	if (PatrolTarget)
+	{
+		SLASH_DRAW_LINE(this, AIRanges, Location, PatrolTarget->GetActorLocation(), FColor::Blue);
+		SLASH_DRAW_CIRCLE(this, AIRanges, PatrolTarget->GetActorLocation(), PatrolRadius, FColor::Blue);
+	}
+}
+
+void AEnemy::SetPatrolTargets(const TArray<AActor*>& InPatrolTargets)
+{
+	PatrolTargets = InPatrolTargets;
+	PatrolTarget = PatrolTargets.Num() > 0 ? PatrolTargets[0] : nullptr;
+	if (HasActorBegunPlay())
+	{
+		BakePatrolRoute();
+	}
+}
+
+void AEnemy::BakePatrolRoute()
+{
+	if (PatrolRoutes == nullptr)
+	{
+		PatrolRoutes = GetWorld()->GetSubsystem<UPatrolRouteSubsystem>();
+	}
+	if (PatrolRoutes == nullptr) return;
+
+	PatrolRoute = PatrolRoutes->RegisterRoute(PatrolTargets);
+	PatrolSlot = PatrolRoutes->FindSlot(PatrolRoute, PatrolTarget);
+	PatrolTargets.Empty();
+}
+
+void AEnemy::SetSignificance(ESignificanceBucket Bucket)
+{
+	// AI rate is already scaled by distance in UEnemyAIDirector and health bars are culled by
+	// UHealthBarSubsystem; animation rate is left to the budget allocator
+	SignificanceBucket = Bucket;
+	UpdateAnimationBudget();
+	UpdateMovementMode();
+}
+
+void AEnemy::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode)
+{
+	Super::OnMovementModeChanged(PrevMovementMode, PreviousCustomMode);
+
+	// Enemies spawned or knocked off the ground can only switch once they're standing again. Leaving
+	// navmesh walking (damage, or no navmesh under the enemy) is deliberate and isn't undone here.
+	if (GetCharacterMovement()->MovementMode == MOVE_Walking && PrevMovementMode != MOVE_NavWalking)
+	{
+		UpdateMovementMode();
+	}
+}
+
+void AEnemy::UpdateMovementMode()
+{
+	const int32 Mode = CVarEnemyLightweightMovement.GetValueOnGameThread();
+	const bool bInsignificant = SignificanceBucket == ESignificanceBucket::Low || SignificanceBucket == ESignificanceBucket::Culled;
+	SetLightweightMovement(EnemyState == EEnemyState::EES_Patrolling && (Mode >= 2 || (Mode == 1 && bInsignificant)));
+}
+
+void AEnemy::SetLightweightMovement(bool bLightweight)
+{
+	UCharacterMovementComponent* Movement = GetCharacterMovement();
+	if (Movement == nullptr) return;
+
+	const bool bNavWalking = Movement->MovementMode == MOVE_NavWalking;
+	if (bLightweight == bNavWalking) return;
+
+	if (bLightweight)
+	{
+		// Only from solid ground; a falling enemy finishes its fall under full simulation first
+		if (Movement->MovementMode != MOVE_Walking) return;
+
+		// Snapped to the navmesh with no floor sweeps, step-ups or capsule collision against the world
+		Movement->bSweepWhileNavWalking = false;
+		Movement->SetMovementMode(MOVE_NavWalking);
+	}
+	else
+	{
+		Movement->SetMovementMode(MOVE_Walking);
+	}
+}
+
+void AEnemy::UpdateAnimationBudget()
+{
+	UBudgetedSkeletalMeshComponent* BudgetedMesh = Cast<UBudgetedSkeletalMeshComponent>(GetMesh());
+	if (BudgetedMesh == nullptr) return;
+
+	static constexpr float BucketSignificance[] = { 1.f, 0.6f, 0.3f, 0.1f };
+	const float Significance = BucketSignificance[static_cast<int32>(SignificanceBucket)];
+
+	// Hit windows come from anim notifies, so an enemy mid-attack must never have frames skipped
+	const bool bNeverSkip = EnemyState == EEnemyState::EES_Attacking || EnemyState == EEnemyState::EES_Engaged;
+	BudgetedMesh->SetComponentSignificance(Significance, bNeverSkip);
+}
+
 bool AEnemy::CanAttack()
 {
 	return IsInsideAttackRadius() && !IsAttacking() && !IsEngaged() && !IsDead();
@@ -117,51 +352,80 @@ bool AEnemy::CanAttack()
 
 void AEnemy::AttackEnd()
 {
-	EnemyState = EEnemyState::EES_Unoccupied;
-	CheckCombatTarget();
+	SetEnemyState(EEnemyState::EES_Unoccupied);
+	ApplyStateActions(EnemyStateTable::Lookup(EnemyState, ComputeRangeFlags()));
 }
 
 bool AEnemy::InTargetRange(AActor* Target, double Radius)
 {
 	if (Target == nullptr) return false;
-	const double DistanceToTarget = (Target->GetActorLocation() - GetActorLocation()).Size();
-	return DistanceToTarget < Radius;
+	const double DistanceToTargetSquared = FVector::DistSquared(Target->GetActorLocation(), GetActorLocation());
+	return DistanceToTargetSquared < Radius * Radius;
+}
+
+EEnemyRangeFlags AEnemy::ComputeRangeFlags()
+{
+	EEnemyRangeFlags Flags = EEnemyRangeFlags::None;
+	if (InTargetRange(CombatTarget, AttackRadius)) Flags |= EEnemyRangeFlags::InAttackRadius;
+	if (InTargetRange(CombatTarget, CombatRadius)) Flags |= EEnemyRangeFlags::InCombatRadius;
+	if (InTargetRange(PatrolTarget, PatrolRadius)) Flags |= EEnemyRangeFlags::InPatrolRadius;
+	return Flags;
+}
+
+void AEnemy::AddRangeQuery(FEnemyRangeBatch& Batch) const
+{
+	const FVector CombatTargetLocation = CombatTarget ? CombatTarget->GetActorLocation() : FVector::ZeroVector;
+	const FVector PatrolTargetLocation = PatrolTarget ? PatrolTarget->GetActorLocation() : FVector::ZeroVector;
+	Batch.Add(
+		GetActorLocation(),
+		CombatTarget ? &CombatTargetLocation : nullptr, AttackRadius, CombatRadius,
+		PatrolTarget ? &PatrolTargetLocation : nullptr, PatrolRadius);
 }
 
 void AEnemy::MoveToTarget(AActor* Target)
 {
 	if (EnemyController == nullptr || Target == nullptr) return;
 
+	if (PathRequests)
+	{
+		PathRequests->RequestMove(this, Target, AcceptanceRadius);
+		return;
+	}
+
 	FAIMoveRequest MoveRequest;
 	MoveRequest.SetCanStrafe(true);
 	MoveRequest.SetGoalActor(Target);
 	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
-	//TODO: Fix 
-	//EnemyController->MoveTo(MoveRequest);
+	EnemyController->MoveTo(MoveRequest);
 }
 
-AActor* AEnemy::PickPatrolTarget()
+void AEnemy::FollowPath(AActor* Goal, FNavPathSharedPtr Path)
 {
-	TArray<AActor*> ValidTargets = PatrolTargets;
-	ValidTargets.Remove(PatrolTarget);
+	// Late results for an enemy that has since stopped to attack must not drag it mid-swing
+	if (EnemyController == nullptr || Goal == nullptr) return;
+	if (EnemyState != EEnemyState::EES_Chasing && EnemyState != EEnemyState::EES_Patrolling) return;
 
-	if (ValidTargets.Num() > 0)
-	{
-		const int32 RandomIndex = FMath::RandRange(0, ValidTargets.Num() - 1);
-		return ValidTargets[RandomIndex];
-	}
+	FAIMoveRequest MoveRequest;
+	MoveRequest.SetCanStrafe(true);
+	MoveRequest.SetGoalActor(Goal);
+	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
+	EnemyController->RequestMove(MoveRequest, Path);
+}
 
-	return nullptr;
+AActor* AEnemy::PickPatrolTarget()
+{
+	if (PatrolRoutes == nullptr) return nullptr;
+
+	PatrolSlot = PatrolRoutes->PickNextSlot(PatrolRoute, PatrolSlot, USlashRandomSubsystem::Get(this, ESlashRandomStream::AI));
+	return PatrolRoutes->GetWaypoint(PatrolRoute, PatrolSlot);
 }
 
 void AEnemy::PawnSeen(APawn* SeenPawn)
 {
 	const bool bShouldChaseTarget =
-		EnemyState != EEnemyState::EES_Dead &&
-		EnemyState != EEnemyState::EES_Chasing &&
-		EnemyState < EEnemyState::EES_Attacking &&
-		!SeenPawn->ActorHasTag(FName("Dead")) && 
-		SeenPawn->ActorHasTag(FName("EngageableTarget"));
+		IsReceptiveToSight() &&
+		!UCombatFlagsComponent::ActorHasAnyFlags(SeenPawn, ECombatFlags::ECF_Dead) &&
+		UCombatFlagsComponent::ActorHasAnyFlags(SeenPawn, ECombatFlags::ECF_EngageableTarget);
 
 	if (bShouldChaseTarget)
 	{
@@ -179,7 +443,10 @@ void AEnemy::ClearPatrolTimer()
 void AEnemy::HandleDamage(float DamageAmount)
 {
 	Super::HandleDamage(DamageAmount);
-	HealthBarWidget->SetHealthPercent(Attributes->GetHealthPercent());
+	if (HealthBars)
+	{
+		HealthBars->SetBarPercent(HealthBarHandle, Attributes->GetHealthPercent());
+	}
 }
 
 void AEnemy::PatrolTimerFinished()
@@ -203,12 +470,14 @@ void AEnemy::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
 
 float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
 {
+	// Hit reactions and knockback need the full simulation whatever state this lands in
+	SetLightweightMovement(false);
 	HandleDamage(DamageAmount);
 	CombatTarget = EventInstigator->GetPawn();
 	
 	if (IsInsideAttackRadius())
 	{
-		EnemyState = EEnemyState::EES_Attacking;
+		SetEnemyState(EEnemyState::EES_Attacking);
 	}
 	else if(IsOutsideAttackRadius())
 	{
@@ -221,11 +490,8 @@ void AEnemy::Destroyed()
 {
 	if (EquippedWeapon)
 	{
-		EquippedWeapon->Destroy();
-	}
-	if (HealthBarWidget)
-	{
-		HealthBarWidget->DestroyComponent();
+		UActorPoolSubsystem::ReleaseOrDestroy(EquippedWeapon);
+		EquippedWeapon = nullptr;
 	}
 	/*
 	if (GetCapsuleComponent())
@@ -235,62 +501,94 @@ void AEnemy::Destroyed()
 	*/
 }
 
-void AEnemy::Tick(float DeltaTime)
+void AEnemy::UpdateAI(EEnemyRangeFlags RangeFlags)
 {
-	Super::Tick(DeltaTime);
-	if (IsDead()) return;
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashEnemyUpdateAI);
+	INC_DWORD_STAT(STAT_SlashEnemyAIUpdates);
 
-	if (EnemyState > EEnemyState::EES_Patrolling)
-	{
-		CheckCombatTarget();
-	}
-	else {
-		CheckPatrolTarget();
-	}
+	// The director computed RangeFlags for this enemy's current targets earlier in the same frame
+	ApplyStateActions(EnemyStateTable::Lookup(EnemyState, RangeFlags));
 }
 
-bool AEnemy::IsPatrolling()
+void AEnemy::ApplyStateActions(EEnemyActions Actions)
 {
-	return EnemyState > EEnemyState::EES_Patrolling;
-}
+	if (Actions == EEnemyActions::None) return;
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashEnemyApplyStateActions);
 
-bool AEnemy::IsDead()
-{
-	return EnemyState == EEnemyState::EES_Dead;
-}
-
-void AEnemy::CheckPatrolTarget()
-{
-	if (InTargetRange(PatrolTarget, PatrolRadius))
+	if (EnumHasAnyFlags(Actions, EEnemyActions::ClearAttackTimer))
+	{
+		ClearAttackTimer();
+	}
+	if (EnumHasAnyFlags(Actions, EEnemyActions::LoseInterest))
+	{
+		LooseInterest();
+	}
+	if (EnumHasAnyFlags(Actions, EEnemyActions::StartPatrolling))
+	{
+		StartPatrolling();
+	}
+	if (EnumHasAnyFlags(Actions, EEnemyActions::StartChasing))
+	{
+		StartChasing();
+	}
+	if (EnumHasAnyFlags(Actions, EEnemyActions::StartAttackTimer))
+	{
+		StartAttackTimer();
+	}
+	if (EnumHasAnyFlags(Actions, EEnemyActions::PickPatrolTarget))
 	{
 		PatrolTarget = PickPatrolTarget();
-		GetWorldTimerManager().SetTimer(PatrolTimer, this, &AEnemy::PatrolTimerFinished, FMath::RandRange(PatrolWaitMin, PatrolWaitMax));
+		const float PatrolWait = USlashRandomSubsystem::Get(this, ESlashRandomStream::AI).FRandRange(PatrolWaitMin, PatrolWaitMax);
+		GetWorldTimerManager().SetTimer(PatrolTimer, this, &AEnemy::PatrolTimerFinished, PatrolWait);
 	}
 }
 
-void AEnemy::CheckCombatTarget()
+void AEnemy::SetEnemyState(EEnemyState NewState)
 {
-	if (IsOutsideCombatRadius())
+	if (EnemyState == NewState) return;
+
+	const bool bWasAttacking = EnemyState == EEnemyState::EES_Attacking || EnemyState == EEnemyState::EES_Engaged;
+	EnemyState = NewState;
+	if (AIDirector)
 	{
-		ClearAttackTimer();
-		LooseInterest();
-		if (!IsEngaged())
-		{
-			StartPatrolling();
-		}
+		AIDirector->NotifyStateChanged(this, NewState);
 	}
-	else if (IsOutsideAttackRadius() && !IsChasing())
+
+	const bool bIsAttacking = EnemyState == EEnemyState::EES_Attacking || EnemyState == EEnemyState::EES_Engaged;
+	if (bWasAttacking != bIsAttacking)
 	{
-		ClearAttackTimer();
-		if (!IsEngaged())
-		{
-			StartChasing();
-		}
+		UpdateAnimationBudget();
 	}
-	else if (CanAttack())
+	UpdateMovementMode();
+
+	// Only chasing and patrolling enemies move; anything else stops sharing its group's re-paths
+	if (PathRequests && EnemyState != EEnemyState::EES_Chasing && EnemyState != EEnemyState::EES_Patrolling)
 	{
-		StartAttackTimer();
+		PathRequests->CancelMove(this);
 	}
+
+	// Enemies keep their crowd slot between swings and only give it up when they leave combat
+	if (Crowd && (EnemyState == EEnemyState::EES_Patrolling || EnemyState == EEnemyState::EES_Dead))
+	{
+		Crowd->RemoveChaser(this);
+	}
+}
+
+bool AEnemy::IsReceptiveToSight() const
+{
+	return EnemyState != EEnemyState::EES_Dead &&
+		EnemyState != EEnemyState::EES_Chasing &&
+		EnemyState < EEnemyState::EES_Attacking;
+}
+
+bool AEnemy::IsPatrolling()
+{
+	return EnemyState > EEnemyState::EES_Patrolling;
+}
+
+bool AEnemy::IsDead()
+{
+	return EnemyState == EEnemyState::EES_Dead;
 }
 
 bool AEnemy::IsEngaged()
@@ -315,8 +613,8 @@ bool AEnemy::IsChasing()
 
 void AEnemy::StartAttackTimer()
 {
-	EnemyState = EEnemyState::EES_Attacking;
-	const float AttackTime = FMath::RandRange(AttackMin, AttackMax);
+	SetEnemyState(EEnemyState::EES_Attacking);
+	const float AttackTime = USlashRandomSubsystem::Get(this, ESlashRandomStream::AI).FRandRange(AttackMin, AttackMax);
 	GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemy::Attack, AttackTime);
 }
 
@@ -342,14 +640,36 @@ bool AEnemy::IsOutsideCombatRadius()
 
 void AEnemy::StartChasing()
 {
-	EnemyState = EEnemyState::EES_Chasing;
+	SetEnemyState(EEnemyState::EES_Chasing);
 	GetCharacterMovement()->MaxWalkSpeed = MaxRunSpeed;
+	if (Crowd && !Crowd->AddChaser(this, CombatTarget)) return;
 	MoveToTarget(CombatTarget);
 }
 
+void AEnemy::SetCrowdAttackSlot(bool bHasSlot)
+{
+	if (bHasSlot)
+	{
+		if (IsChasing())
+		{
+			MoveToTarget(CombatTarget);
+		}
+		return;
+	}
+
+	if (PathRequests)
+	{
+		PathRequests->CancelMove(this);
+	}
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+	}
+}
+
 void AEnemy::StartPatrolling()
 {
-	EnemyState = EEnemyState::EES_Patrolling;
+	SetEnemyState(EEnemyState::EES_Patrolling);
 	GetCharacterMovement()->MaxWalkSpeed = MaxWalkSpeed;
 	MoveToTarget(PatrolTarget);
 }
@@ -362,16 +682,16 @@ void AEnemy::LooseInterest()
 
 void AEnemy::HideHealthBar()
 {
-	if (HealthBarWidget)
+	if (HealthBars)
 	{
-		HealthBarWidget->SetVisibility(false);
+		HealthBars->SetBarVisible(HealthBarHandle, false);
 	}
 }
 
 void AEnemy::ShowHealthBar()
 {
-	if (HealthBarWidget && !IsDead())
+	if (HealthBars && !IsDead())
 	{
-		HealthBarWidget->SetVisibility(true);
+		HealthBars->SetBarVisible(HealthBarHandle, true);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyAIDirector.h"
+#include "Enemy/Enemy.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Components/BudgetedSkeletalMeshComponent.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<int32> CVarEnemyAIMaxUpdatesPerFrame(
+	TEXT("Slash.AI.MaxUpdatesPerFrame"),
+	64,
+	TEXT("Maximum number of patrolling enemies the AI director updates per frame. Engaged enemies are always updated."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyAINearInterval(
+	TEXT("Slash.AI.NearUpdateInterval"),
+	0.1f,
+	TEXT("Seconds between AI updates for patrolling enemies within FarDistance of a player."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyAIFarInterval(
+	TEXT("Slash.AI.FarUpdateInterval"),
+	0.5f,
+	TEXT("Seconds between AI updates for patrolling enemies beyond FarDistance of every player."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyAIFarDistance(
+	TEXT("Slash.AI.FarDistance"),
+	4000.f,
+	TEXT("Distance from the nearest player at which patrolling enemies drop to the far update interval."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Budget Meshes Evaluated"), STAT_SlashAnimBudgetEvaluated, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Anim Budget Meshes Skipped"), STAT_SlashAnimBudgetSkipped, STATGROUP_Slash);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Anim Budget Est. Saved (ms)"), STAT_SlashAnimBudgetSavedMs, STATGROUP_Slash);
+
+void UEnemyAIDirector::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("AIDirector");
+
+	const int32 NumEnemies = Enemies.Num();
+	if (NumEnemies == 0) return;
+
+#if STATS
+	UpdateAnimationBudgetStats();
+#endif
+
+#if SLASH_DEBUG_DRAW
+	// Patrolling enemies update on a budget, so ranges are drawn for everyone here rather than in UpdateAI
+	if (USlashDebugDrawSubsystem::IsEnabled(ESlashDebugDraw::AIRanges))
+	{
+		for (const AEnemy* Enemy : Enemies)
+		{
+			if (Enemy)
+			{
+				Enemy->DrawDebugRanges();
+			}
+		}
+	}
+#endif
+
+	TArray<FVector> ViewerLocations;
+	GatherViewerLocations(ViewerLocations);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const int32 Budget = FMath::Max(1, CVarEnemyAIMaxUpdatesPerFrame.GetValueOnGameThread());
+	int32 BudgetedUpdates = 0;
+	int32 NextCursor = INDEX_NONE;
+
+	// Pick this frame's slice first so the range checks for all of it can run as one batch
+	DueIndices.Reset();
+	for (int32 Step = 0; Step < NumEnemies; ++Step)
+	{
+		const int32 Index = (Cursor + Step) % NumEnemies;
+		if (NextUpdateTimes[Index] > Now || Enemies[Index] == nullptr) continue;
+
+		// Anything that isn't calmly patrolling reacts to its target every frame, exactly like the old per-actor Tick.
+		const bool bEngaged = States[Index] != EEnemyState::EES_Patrolling;
+		if (!bEngaged)
+		{
+			if (BudgetedUpdates >= Budget)
+			{
+				if (NextCursor == INDEX_NONE) NextCursor = Index;
+				continue;
+			}
+			++BudgetedUpdates;
+		}
+		DueIndices.Add(Index);
+	}
+
+	if (NextCursor != INDEX_NONE)
+	{
+		Cursor = NextCursor;
+	}
+
+	RangeBatch.Reset(ViewerLocations.Num() > 0 ? ViewerLocations[0] : FVector::ZeroVector, DueIndices.Num());
+	for (const int32 Index : DueIndices)
+	{
+		Enemies[Index]->AddRangeQuery(RangeBatch);
+	}
+	RangeBatch.Compute();
+
+	for (int32 Slot = 0; Slot < DueIndices.Num(); ++Slot)
+	{
+		const int32 Index = DueIndices[Slot];
+		UpdateEnemy(Index, RangeBatch.GetFlags(Slot));
+
+		// An update may unregister enemies; restart the slicing next frame rather than walk a stale range.
+		if (Enemies.Num() != NumEnemies) return;
+
+		NextUpdateTimes[Index] = Now + GetUpdateInterval(Index, ViewerLocations);
+	}
+}
+
+void UEnemyAIDirector::UpdateAnimationBudgetStats() const
+{
+	// Mesh ticks run before tickable objects, so this frame's evaluations are already known
+	int32 NumEvaluated = 0;
+	int32 NumSkipped = 0;
+	for (const AEnemy* Enemy : Enemies)
+	{
+		const UBudgetedSkeletalMeshComponent* Mesh = Enemy ? Cast<UBudgetedSkeletalMeshComponent>(Enemy->GetMesh()) : nullptr;
+		if (Mesh == nullptr || !Mesh->IsRegistered()) continue;
+
+		if (Mesh->PoseTickedThisFrame())
+		{
+			++NumEvaluated;
+		}
+		else
+		{
+			++NumSkipped;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SlashAnimBudgetEvaluated, NumEvaluated);
+	SET_DWORD_STAT(STAT_SlashAnimBudgetSkipped, NumSkipped);
+	SET_FLOAT_STAT(STAT_SlashAnimBudgetSavedMs, NumSkipped * AverageMeshEvaluationMs);
+}
+
+void UEnemyAIDirector::ReportMeshEvaluation(float Ms)
+{
+	AverageMeshEvaluationMs = AverageMeshEvaluationMs > 0.f ? FMath::Lerp(AverageMeshEvaluationMs, Ms, 0.05f) : Ms;
+}
+
+TStatId UEnemyAIDirector::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAIDirector, STATGROUP_Tickables);
+}
+
+void UEnemyAIDirector::Deinitialize()
+{
+	for (AEnemy* Enemy : Enemies)
+	{
+		if (Enemy)
+		{
+			Enemy->SetAIDirectorHandle(INDEX_NONE);
+		}
+	}
+	Enemies.Empty();
+	CachedLocations.Empty();
+	States.Empty();
+	NextUpdateTimes.Empty();
+	AverageMeshEvaluationMs = 0.f;
+
+	Super::Deinitialize();
+}
+
+void UEnemyAIDirector::RegisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr || Enemy->GetAIDirectorHandle() != INDEX_NONE) return;
+
+	const int32 Index = Enemies.Add(Enemy);
+	CachedLocations.Add(Enemy->GetActorLocation());
+	States.Add(Enemy->GetEnemyState());
+	NextUpdateTimes.Add(0.0);
+	Enemy->SetAIDirectorHandle(Index);
+}
+
+void UEnemyAIDirector::UnregisterEnemy(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	const int32 Index = Enemy->GetAIDirectorHandle();
+	if (!Enemies.IsValidIndex(Index) || Enemies[Index] != Enemy) return;
+
+	Enemies.RemoveAtSwap(Index, 1, false);
+	CachedLocations.RemoveAtSwap(Index, 1, false);
+	States.RemoveAtSwap(Index, 1, false);
+	NextUpdateTimes.RemoveAtSwap(Index, 1, false);
+	Enemy->SetAIDirectorHandle(INDEX_NONE);
+
+	if (Enemies.IsValidIndex(Index) && Enemies[Index])
+	{
+		Enemies[Index]->SetAIDirectorHandle(Index);
+	}
+	if (Cursor >= Enemies.Num())
+	{
+		Cursor = 0;
+	}
+}
+
+void UEnemyAIDirector::NotifyStateChanged(const AEnemy* Enemy, EEnemyState NewState)
+{
+	const int32 Index = Enemy->GetAIDirectorHandle();
+	if (!States.IsValidIndex(Index)) return;
+
+	States[Index] = NewState;
+	if (NewState != EEnemyState::EES_Patrolling)
+	{
+		NextUpdateTimes[Index] = 0.0;
+	}
+}
+
+float UEnemyAIDirector::GetUpdateInterval(int32 Index, const TArray<FVector>& ViewerLocations) const
+{
+	if (States[Index] != EEnemyState::EES_Patrolling) return 0.f;
+
+	const double FarDistance = CVarEnemyAIFarDistance.GetValueOnGameThread();
+	const double FarDistanceSquared = FarDistance * FarDistance;
+	for (const FVector& ViewerLocation : ViewerLocations)
+	{
+		if (FVector::DistSquared(ViewerLocation, CachedLocations[Index]) < FarDistanceSquared)
+		{
+			return CVarEnemyAINearInterval.GetValueOnGameThread();
+		}
+	}
+	return CVarEnemyAIFarInterval.GetValueOnGameThread();
+}
+
+void UEnemyAIDirector::GatherViewerLocations(TArray<FVector>& OutLocations) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (PlayerController && PlayerController->GetPawn())
+		{
+			OutLocations.Add(PlayerController->GetPawn()->GetActorLocation());
+		}
+	}
+}
+
+void UEnemyAIDirector::UpdateEnemy(int32 Index, EEnemyRangeFlags RangeFlags)
+{
+	AEnemy* Enemy = Enemies[Index];
+	Enemy->UpdateAI(RangeFlags);
+	CachedLocations[Index] = Enemy->GetActorLocation();
+}
@@ -0,0 +1,272 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyCrowdSubsystem.h"
+#include "Enemy/Enemy.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<int32> CVarEnemyCrowd(
+	TEXT("Slash.AI.Crowd"),
+	0,
+	TEXT("1 = only Slash.AI.AttackSlots enemies per target path to it; the rest hold at a ring around it."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarEnemyAttackSlots(
+	TEXT("Slash.AI.AttackSlots"),
+	3,
+	TEXT("Enemies per target allowed to path to it when Slash.AI.Crowd is on."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyHoldRingRadius(
+	TEXT("Slash.AI.HoldRingRadius"),
+	450.f,
+	TEXT("Distance from the target at which enemies without an attack slot hold."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemySeparationRadius(
+	TEXT("Slash.AI.SeparationRadius"),
+	120.f,
+	TEXT("Holding enemies steer away from neighbours closer than this."),
+	ECVF_Default);
+
+namespace EnemyCrowd
+{
+	/** A slot holder keeps its slot until a challenger is this much closer, so slots don't flicker. */
+	constexpr double SlotHysteresis = 150.0;
+
+	/** Holders within this distance of their ring point stop seeking it. */
+	constexpr double ArriveTolerance = 40.0;
+
+	/** Seeking slows down linearly inside this distance of the ring point. */
+	constexpr double SlowRadius = 200.0;
+}
+
+DECLARE_CYCLE_STAT(TEXT("Crowd Steering"), STAT_SlashCrowdSteering, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Chasers"), STAT_SlashCrowdChasers, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Crowd Holding"), STAT_SlashCrowdHolding, STATGROUP_Slash);
+
+void UEnemyCrowdSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("Crowd");
+
+	if (CVarEnemyCrowd.GetValueOnGameThread() == 0)
+	{
+		ReleaseAll();
+		return;
+	}
+
+	for (int32 Index = Chasers.Num() - 1; Index >= 0; --Index)
+	{
+		if (Chasers[Index] == nullptr || Chasers[Index]->IsDead() || !ChaseTargets[Index].IsValid())
+		{
+			RemoveChaserAt(Index);
+		}
+	}
+	SET_DWORD_STAT(STAT_SlashCrowdChasers, Chasers.Num());
+	if (Chasers.Num() == 0) return;
+
+	Locations.Reset(Chasers.Num());
+	TargetLocations.Reset(Chasers.Num());
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		Locations.Add(Chasers[Index]->GetActorLocation());
+		TargetLocations.Add(ChaseTargets[Index]->GetActorLocation());
+	}
+
+	AssignAttackSlots();
+	ComputeSteering();
+
+	int32 NumHolding = 0;
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		if (HasSlot[Index]) continue;
+
+		++NumHolding;
+		if (!Steering[Index].IsNearlyZero())
+		{
+			Chasers[Index]->AddMovementInput(Steering[Index], Steering[Index].Size());
+		}
+	}
+	SET_DWORD_STAT(STAT_SlashCrowdHolding, NumHolding);
+}
+
+TStatId UEnemyCrowdSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyCrowdSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyCrowdSubsystem::Deinitialize()
+{
+	Chasers.Empty();
+	ChaseTargets.Empty();
+	HasSlot.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UEnemyCrowdSubsystem::AddChaser(AEnemy* Enemy, AActor* Target)
+{
+	if (CVarEnemyCrowd.GetValueOnGameThread() == 0 || Enemy == nullptr || Target == nullptr) return true;
+
+	const int32 Existing = Chasers.Find(Enemy);
+	if (Existing != INDEX_NONE)
+	{
+		if (ChaseTargets[Existing] == Target) return HasSlot[Existing];
+		RemoveChaserAt(Existing);
+	}
+
+	// Take a free slot straight away; Tick rebalances by distance from then on
+	const bool bSlot = CountSlots(Target) < CVarEnemyAttackSlots.GetValueOnGameThread();
+	Chasers.Add(Enemy);
+	ChaseTargets.Add(Target);
+	HasSlot.Add(bSlot);
+	return bSlot;
+}
+
+void UEnemyCrowdSubsystem::RemoveChaser(AEnemy* Enemy)
+{
+	const int32 Index = Chasers.Find(Enemy);
+	if (Index != INDEX_NONE)
+	{
+		RemoveChaserAt(Index);
+	}
+}
+
+void UEnemyCrowdSubsystem::RemoveChaserAt(int32 Index)
+{
+	Chasers.RemoveAtSwap(Index, 1, false);
+	ChaseTargets.RemoveAtSwap(Index, 1, false);
+	HasSlot.RemoveAtSwap(Index, 1, false);
+}
+
+void UEnemyCrowdSubsystem::ReleaseAll()
+{
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		if (!HasSlot[Index] && Chasers[Index])
+		{
+			Chasers[Index]->SetCrowdAttackSlot(true);
+		}
+	}
+	Chasers.Reset();
+	ChaseTargets.Reset();
+	HasSlot.Reset();
+}
+
+int32 UEnemyCrowdSubsystem::CountSlots(const AActor* Target) const
+{
+	int32 NumSlots = 0;
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		NumSlots += HasSlot[Index] && ChaseTargets[Index] == Target;
+	}
+	return NumSlots;
+}
+
+void UEnemyCrowdSubsystem::AssignAttackSlots()
+{
+	const int32 MaxSlots = FMath::Max(1, CVarEnemyAttackSlots.GetValueOnGameThread());
+
+	// Order by target, then by distance to it; slot holders get a head start
+	TArray<double, TInlineAllocator<64>> SortKeys;
+	SortKeys.SetNumUninitialized(Chasers.Num());
+	SlotOrder.Reset(Chasers.Num());
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		const double Distance = FVector::Dist2D(Locations[Index], TargetLocations[Index]);
+		SortKeys[Index] = HasSlot[Index] ? Distance - EnemyCrowd::SlotHysteresis : Distance;
+		SlotOrder.Add(Index);
+	}
+	SlotOrder.Sort([this, &SortKeys](int32 A, int32 B)
+	{
+		const AActor* TargetA = ChaseTargets[A].Get();
+		const AActor* TargetB = ChaseTargets[B].Get();
+		return TargetA != TargetB ? TargetA < TargetB : SortKeys[A] < SortKeys[B];
+	});
+
+	int32 Rank = 0;
+	for (int32 Position = 0; Position < SlotOrder.Num(); ++Position)
+	{
+		const int32 Index = SlotOrder[Position];
+		if (Position > 0 && ChaseTargets[SlotOrder[Position - 1]] != ChaseTargets[Index])
+		{
+			Rank = 0;
+		}
+
+		AEnemy* Enemy = Chasers[Index];
+		// An enemy mid-swing keeps its slot no matter who is closer
+		const bool bSlot = Rank < MaxSlots || (HasSlot[Index] && (Enemy->IsAttacking() || Enemy->IsEngaged()));
+		Rank += bSlot;
+
+		if (bSlot != HasSlot[Index])
+		{
+			HasSlot[Index] = bSlot;
+			Enemy->SetCrowdAttackSlot(bSlot);
+		}
+	}
+}
+
+void UEnemyCrowdSubsystem::ComputeSteering()
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashCrowdSteering);
+
+	const float SeparationRadius = FMath::Max(1.f, CVarEnemySeparationRadius.GetValueOnGameThread());
+	const double HoldRingRadius = CVarEnemyHoldRingRadius.GetValueOnGameThread();
+
+	// A cell per separation radius keeps each query to a 3x3 block of cells
+	Grid.SetCellSize(SeparationRadius);
+	Grid.Build(Locations);
+	Steering.SetNumUninitialized(Chasers.Num());
+
+	// Read-only over the grid and the snapshots; each iteration writes only its own Steering entry
+	ParallelFor(Chasers.Num(), [this, SeparationRadius, HoldRingRadius](int32 Index)
+	{
+		if (HasSlot[Index])
+		{
+			Steering[Index] = FVector::ZeroVector;
+			return;
+		}
+
+		const FVector& Location = Locations[Index];
+		const FVector FromTarget = (Location - TargetLocations[Index]).GetSafeNormal2D();
+		const FVector RingPoint = TargetLocations[Index] + FromTarget * HoldRingRadius;
+
+		FVector Seek = RingPoint - Location;
+		Seek.Z = 0.0;
+		const double SeekDistance = Seek.Size();
+		Seek = SeekDistance > EnemyCrowd::ArriveTolerance
+			? Seek / SeekDistance * FMath::Min(1.0, SeekDistance / EnemyCrowd::SlowRadius)
+			: FVector::ZeroVector;
+
+		TArray<int32, TInlineAllocator<16>> Neighbors;
+		Grid.QueryRadius(Location, SeparationRadius, Neighbors);
+
+		FVector Separation = FVector::ZeroVector;
+		for (const int32 Neighbor : Neighbors)
+		{
+			if (Neighbor == Index) continue;
+
+			FVector Away = Location - Locations[Neighbor];
+			Away.Z = 0.0;
+			const double Distance = Away.Size();
+			Separation += Distance > UE_KINDA_SMALL_NUMBER
+				? Away / Distance * (1.0 - Distance / SeparationRadius)
+				: FVector(FMath::Cos(double(Index)), FMath::Sin(double(Index)), 0.0);
+		}
+
+		Steering[Index] = (Seek + Separation).GetClampedToMaxSize(1.0);
+	}, Chasers.Num() < 64 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+#if SLASH_DEBUG_DRAW
+	for (int32 Index = 0; Index < Chasers.Num(); ++Index)
+	{
+		if (!HasSlot[Index])
+		{
+			SLASH_DRAW_LINE(this, AIRanges, Locations[Index], Locations[Index] + Steering[Index] * 100.0, FColor::Cyan);
+		}
+	}
+#endif
+}
@@ -0,0 +1,346 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyPathSubsystem.h"
+#include "Enemy/Enemy.h"
+#include "Engine/World.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<int32> CVarEnemyMaxPathfindsPerFrame(
+	TEXT("Slash.AI.MaxPathfindsPerFrame"),
+	8,
+	TEXT("Async navmesh queries the enemy path queue starts per frame; the rest wait their turn."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyPathShareCellSize(
+	TEXT("Slash.AI.PathShareCellSize"),
+	800.f,
+	TEXT("Enemies starting within the same cell of this size and heading for the same goal share one path."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarEnemyPathShareRadius(
+	TEXT("Slash.AI.PathShareRadius"),
+	300.f,
+	TEXT("Group members farther than this from where the shared query started get a path of their own."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pathfinds Issued"), STAT_SlashPathfindsIssued, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Shared"), STAT_SlashPathRequestsShared, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Requests Solo"), STAT_SlashPathRequestsSolo, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Path Groups"), STAT_SlashPathGroups, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pathfinds Queued"), STAT_SlashPathfindsQueued, STATGROUP_Slash);
+
+void UEnemyPathSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("EnemyPaths");
+
+	// Groups whose goal has wandered off re-path; members keep walking their old path until the new one lands
+	for (TPair<FPathKey, FPathGroup>& Pair : Groups)
+	{
+		FPathGroup& Group = Pair.Value;
+		const AActor* Goal = Group.Goal.Get();
+		if (Goal == nullptr || Group.Members.Num() == 0 || !Group.bPathed || Group.bQueued || Group.QueryId != 0) continue;
+
+		if (FVector::DistSquared(Goal->GetActorLocation(), Group.PathedGoalLocation) > FMath::Square(Group.AcceptanceRadius))
+		{
+			Enqueue(Pair.Key, Group);
+		}
+	}
+
+	const int32 Budget = FMath::Max(1, CVarEnemyMaxPathfindsPerFrame.GetValueOnGameThread());
+	int32 NumIssued = 0;
+	while (NumIssued < Budget && !Queue.IsEmpty())
+	{
+		const FPathKey Key = Queue.PopFrontValue();
+
+		FPathGroup* Group = Groups.Find(Key);
+		if (Group == nullptr || !Group->bQueued) continue;
+
+		Group->bQueued = false;
+		IssueQuery(Key, *Group);
+		++NumIssued;
+	}
+	while (NumIssued < Budget && !SoloQueue.IsEmpty())
+	{
+		const TObjectKey<AEnemy> EnemyKey = SoloQueue.PopFrontValue();
+		TWeakObjectPtr<AActor> Goal;
+		SoloGoals.RemoveAndCopyValue(EnemyKey, Goal);
+		NumIssued += IssueSoloQuery(EnemyKey.ResolveObjectPtr(), Goal.Get());
+	}
+
+	for (auto It = Groups.CreateIterator(); It; ++It)
+	{
+		FPathGroup& Group = It->Value;
+		Group.Members.RemoveAllSwap([](const TWeakObjectPtr<AEnemy>& Member) { return !Member.IsValid(); }, false);
+		if ((Group.Members.Num() == 0 && Group.QueryId == 0) || !Group.Goal.IsValid())
+		{
+			for (const TWeakObjectPtr<AEnemy>& Member : Group.Members)
+			{
+				MemberGroups.Remove(Member.Get());
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SlashPathGroups, Groups.Num());
+	SET_DWORD_STAT(STAT_SlashPathfindsQueued, Queue.Num() + SoloQueue.Num());
+}
+
+TStatId UEnemyPathSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPathSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyPathSubsystem::Deinitialize()
+{
+	Groups.Empty();
+	MemberGroups.Empty();
+	Queue.Empty();
+	PendingQueries.Empty();
+	SoloQueue.Empty();
+	SoloGoals.Empty();
+	SoloQueries.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyPathSubsystem::RequestMove(AEnemy* Enemy, AActor* Goal, float AcceptanceRadius)
+{
+	if (Enemy == nullptr || Goal == nullptr) return;
+
+	RemoveMember(Enemy);
+
+	const float CellSize = FMath::Max(100.f, CVarEnemyPathShareCellSize.GetValueOnGameThread());
+	const FVector Location = Enemy->GetActorLocation();
+	FPathKey Key;
+	Key.Goal = Goal;
+	Key.Cell = FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+
+	FPathGroup& Group = Groups.FindOrAdd(Key);
+	const bool bNewGroup = Group.Members.Num() == 0 && !Group.bPathed && !Group.bQueued && Group.QueryId == 0;
+	Group.Goal = Goal;
+	Group.Members.Add(Enemy);
+	Group.AcceptanceRadius = bNewGroup ? AcceptanceRadius : FMath::Min(Group.AcceptanceRadius, AcceptanceRadius);
+	MemberGroups.Add(Enemy, Key);
+
+	const bool bGoalMoved = FVector::DistSquared(Goal->GetActorLocation(), Group.PathedGoalLocation) > FMath::Square(Group.AcceptanceRadius);
+	if (Group.bPathed && !bGoalMoved)
+	{
+		INC_DWORD_STAT(STAT_SlashPathRequestsShared);
+		ApplyPath(Enemy, Group);
+	}
+	else if (Group.bQueued || Group.QueryId != 0)
+	{
+		// Joins the query already on its way
+		INC_DWORD_STAT(STAT_SlashPathRequestsShared);
+	}
+	else
+	{
+		Enqueue(Key, Group);
+	}
+}
+
+void UEnemyPathSubsystem::CancelMove(AEnemy* Enemy)
+{
+	RemoveMember(Enemy);
+}
+
+void UEnemyPathSubsystem::RemoveMember(AEnemy* Enemy)
+{
+	FPathKey Key;
+	if (!MemberGroups.RemoveAndCopyValue(Enemy, Key)) return;
+
+	if (FPathGroup* Group = Groups.Find(Key))
+	{
+		Group->Members.RemoveSingleSwap(Enemy, false);
+	}
+}
+
+void UEnemyPathSubsystem::Enqueue(const FPathKey& Key, FPathGroup& Group)
+{
+	if (Group.bQueued) return;
+
+	Group.bQueued = true;
+	Queue.Add(Key);
+}
+
+void UEnemyPathSubsystem::EnqueueSolo(AEnemy* Enemy, AActor* Goal)
+{
+	// Already waiting its turn: the query goes to wherever it was sent last
+	TWeakObjectPtr<AActor>* QueuedGoal = SoloGoals.Find(Enemy);
+	if (QueuedGoal)
+	{
+		*QueuedGoal = Goal;
+		return;
+	}
+
+	SoloGoals.Add(Enemy, Goal);
+	SoloQueue.Add(Enemy);
+	INC_DWORD_STAT(STAT_SlashPathRequestsSolo);
+}
+
+AEnemy* UEnemyPathSubsystem::PickRepresentative(const FPathGroup& Group) const
+{
+	// The member nearest the group's centre keeps the connectors of everyone else short
+	FVector Centre = FVector::ZeroVector;
+	int32 NumMembers = 0;
+	for (const TWeakObjectPtr<AEnemy>& Member : Group.Members)
+	{
+		if (const AEnemy* Enemy = Member.Get())
+		{
+			Centre += Enemy->GetActorLocation();
+			++NumMembers;
+		}
+	}
+	if (NumMembers == 0) return nullptr;
+	Centre /= NumMembers;
+
+	AEnemy* Representative = nullptr;
+	double BestDistSquared = TNumericLimits<double>::Max();
+	for (const TWeakObjectPtr<AEnemy>& Member : Group.Members)
+	{
+		AEnemy* Enemy = Member.Get();
+		const double DistSquared = Enemy ? FVector::DistSquared2D(Enemy->GetActorLocation(), Centre) : BestDistSquared;
+		if (DistSquared < BestDistSquared)
+		{
+			Representative = Enemy;
+			BestDistSquared = DistSquared;
+		}
+	}
+	return Representative;
+}
+
+uint32 UEnemyPathSubsystem::FindPathAsync(AEnemy* Querier, const FVector& Start, const FVector& End)
+{
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (NavSys == nullptr) return 0;
+
+	const FNavAgentProperties& AgentProperties = Querier->GetNavAgentPropertiesRef();
+	const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, Start);
+	if (NavData == nullptr) return 0;
+
+	FPathFindingQuery Query(Querier, *NavData, Start, End);
+	Query.SetAllowPartialPaths(true);
+	const uint32 QueryId = NavSys->FindPathAsync(AgentProperties, Query, FNavPathQueryDelegate::CreateUObject(this, &UEnemyPathSubsystem::OnPathFound));
+	if (QueryId != 0)
+	{
+		INC_DWORD_STAT(STAT_SlashPathfindsIssued);
+	}
+	return QueryId;
+}
+
+void UEnemyPathSubsystem::IssueQuery(const FPathKey& Key, FPathGroup& Group)
+{
+	AActor* Goal = Group.Goal.Get();
+	AEnemy* Representative = PickRepresentative(Group);
+	if (Goal == nullptr || Representative == nullptr) return;
+
+	// Remember where the goal was even if the query fails, so a stuck group doesn't re-query every frame
+	Group.StartLocation = Representative->GetActorLocation();
+	Group.PathedGoalLocation = Goal->GetActorLocation();
+	Group.bPathed = true;
+
+	Group.QueryId = FindPathAsync(Representative, Group.StartLocation, Group.PathedGoalLocation);
+	if (Group.QueryId != 0)
+	{
+		PendingQueries.Add(Group.QueryId, Key);
+	}
+}
+
+bool UEnemyPathSubsystem::IssueSoloQuery(AEnemy* Enemy, AActor* Goal)
+{
+	if (Enemy == nullptr || Goal == nullptr || !IsMemberHeadingFor(Enemy, Goal)) return false;
+
+	const uint32 QueryId = FindPathAsync(Enemy, Enemy->GetActorLocation(), Goal->GetActorLocation());
+	if (QueryId == 0) return false;
+
+	FSoloRequest& Request = SoloQueries.Add(QueryId);
+	Request.Enemy = Enemy;
+	Request.Goal = Goal;
+	return true;
+}
+
+bool UEnemyPathSubsystem::IsMemberHeadingFor(const AEnemy* Enemy, const AActor* Goal) const
+{
+	const FPathKey* Key = MemberGroups.Find(Enemy);
+	return Key && Key->Goal == TObjectKey<AActor>(Goal);
+}
+
+void UEnemyPathSubsystem::OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+	FSoloRequest Solo;
+	if (SoloQueries.RemoveAndCopyValue(QueryId, Solo))
+	{
+		// Dropped if the enemy has since been cancelled or sent somewhere else
+		AEnemy* Enemy = Solo.Enemy.Get();
+		AActor* Goal = Solo.Goal.Get();
+		if (Enemy && Goal && IsMemberHeadingFor(Enemy, Goal) && Result == ENavigationQueryResult::Success && Path.IsValid())
+		{
+			Enemy->FollowPath(Goal, Path);
+		}
+		return;
+	}
+
+	FPathKey Key;
+	if (!PendingQueries.RemoveAndCopyValue(QueryId, Key)) return;
+
+	FPathGroup* Group = Groups.Find(Key);
+	if (Group == nullptr || Group->QueryId != QueryId) return;
+
+	Group->QueryId = 0;
+	Group->PathPoints.Reset();
+	if (Result == ENavigationQueryResult::Success && Path.IsValid())
+	{
+		for (const FNavPathPoint& Point : Path->GetPathPoints())
+		{
+			Group->PathPoints.Add(Point.Location);
+		}
+	}
+
+	// ApplyPath can't change membership, so iterating the live array is safe
+	for (const TWeakObjectPtr<AEnemy>& Member : Group->Members)
+	{
+		if (AEnemy* Enemy = Member.Get())
+		{
+			ApplyPath(Enemy, *Group);
+		}
+	}
+}
+
+bool UEnemyPathSubsystem::CanSharePath(const AEnemy* Enemy, const FPathGroup& Group) const
+{
+	const FVector Location = Enemy->GetActorLocation();
+	const float ShareRadius = CVarEnemyPathShareRadius.GetValueOnGameThread();
+	if (FVector::DistSquared2D(Location, Group.StartLocation) > FMath::Square(ShareRadius)) return false;
+
+	// The connector onto the shared path was never part of the query; a wall or ledge between
+	// the two must not be walked through
+	const UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	const ANavigationData* NavData = NavSys ? NavSys->GetNavDataForProps(Enemy->GetNavAgentPropertiesRef(), Location) : nullptr;
+	if (NavData == nullptr) return false;
+
+	FVector HitLocation;
+	return !NavData->Raycast(Location, Group.PathPoints[1], HitLocation, NavData->GetDefaultQueryFilter(), Enemy);
+}
+
+void UEnemyPathSubsystem::ApplyPath(AEnemy* Enemy, const FPathGroup& Group)
+{
+	if (Group.PathPoints.Num() < 2) return;
+
+	if (!CanSharePath(Enemy, Group))
+	{
+		EnqueueSolo(Enemy, Group.Goal.Get());
+		return;
+	}
+
+	// Each member walks from where it stands onto the shared path, and gets its own copy because
+	// path following keeps per-path state
+	TArray<FVector> Points;
+	Points.Reserve(Group.PathPoints.Num());
+	Points.Add(Enemy->GetActorLocation());
+	Points.Append(&Group.PathPoints[1], Group.PathPoints.Num() - 1);
+
+	Enemy->FollowPath(Group.Goal.Get(), MakeShared<FNavigationPath, ESPMode::ThreadSafe>(Points));
+}
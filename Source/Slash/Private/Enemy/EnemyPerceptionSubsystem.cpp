@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyPerceptionSubsystem.h"
+#include "Enemy/Enemy.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<float> CVarEnemyPerceptionInterval(
+	TEXT("Slash.AI.PerceptionInterval"),
+	0.5f,
+	TEXT("Seconds between batched enemy sight passes (matches UPawnSensingComponent::SensingInterval)."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sight Traces Issued"), STAT_SlashSightTracesIssued, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Sight Traces Consumed"), STAT_SlashSightTracesConsumed, STATGROUP_Slash);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Sight Trace Avg Latency (ms)"), STAT_SlashSightTraceLatency, STATGROUP_Slash);
+
+void UEnemyPerceptionSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("Perception");
+
+	// Last frame's traces have completed by now; resolve them before issuing a new pass
+	ConsumeSightTraces();
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < NextSensingTime) return;
+	NextSensingTime = Now + CVarEnemyPerceptionInterval.GetValueOnGameThread();
+
+	RunSensingPass();
+}
+
+TStatId UEnemyPerceptionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyPerceptionSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyPerceptionSubsystem::Deinitialize()
+{
+	for (AEnemy* Sensor : Sensors)
+	{
+		if (Sensor)
+		{
+			Sensor->SetPerceptionHandle(INDEX_NONE);
+		}
+	}
+	Sensors.Empty();
+	SightRadii.Empty();
+	CosPeripheralVisionAngles.Empty();
+	Targets.Empty();
+	PendingTraces.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyPerceptionSubsystem::RegisterSensor(AEnemy* Enemy, float SightRadius, float PeripheralVisionAngle)
+{
+	if (Enemy == nullptr || Enemy->GetPerceptionHandle() != INDEX_NONE) return;
+
+	Enemy->SetPerceptionHandle(Sensors.Add(Enemy));
+	SightRadii.Add(SightRadius);
+	CosPeripheralVisionAngles.Add(FMath::Cos(FMath::DegreesToRadians(PeripheralVisionAngle)));
+	MaxSightRadius = FMath::Max(MaxSightRadius, SightRadius);
+}
+
+void UEnemyPerceptionSubsystem::UnregisterSensor(AEnemy* Enemy)
+{
+	if (Enemy == nullptr) return;
+
+	const int32 Index = Enemy->GetPerceptionHandle();
+	if (!Sensors.IsValidIndex(Index) || Sensors[Index] != Enemy) return;
+
+	Sensors.RemoveAtSwap(Index, 1, false);
+	SightRadii.RemoveAtSwap(Index, 1, false);
+	CosPeripheralVisionAngles.RemoveAtSwap(Index, 1, false);
+	Enemy->SetPerceptionHandle(INDEX_NONE);
+
+	// The last sensor was swapped into the hole; keep its handle pointing at it
+	if (Sensors.IsValidIndex(Index) && Sensors[Index])
+	{
+		Sensors[Index]->SetPerceptionHandle(Index);
+	}
+}
+
+void UEnemyPerceptionSubsystem::RegisterTarget(APawn* Pawn)
+{
+	if (Pawn)
+	{
+		Targets.AddUnique(Pawn);
+	}
+}
+
+void UEnemyPerceptionSubsystem::UnregisterTarget(APawn* Pawn)
+{
+	Targets.RemoveSingleSwap(Pawn, false);
+}
+
+void UEnemyPerceptionSubsystem::GatherTargets()
+{
+	PassTargets.Reset();
+	PassTargetLocations.Reset();
+	for (APawn* Target : Targets)
+	{
+		if (Target)
+		{
+			PassTargets.Add(Target);
+			PassTargetLocations.Add(Target->GetActorLocation());
+		}
+	}
+
+	// A cell per sight radius keeps each sensor's query to a 3x3 block of cells
+	TargetGrid.SetCellSize(MaxSightRadius);
+	TargetGrid.Build(PassTargetLocations);
+}
+
+void UEnemyPerceptionSubsystem::RunSensingPass()
+{
+	if (Sensors.Num() == 0 || Targets.Num() == 0) return;
+
+	GatherTargets();
+	if (PassTargets.Num() == 0) return;
+
+	TArray<int32, TInlineAllocator<16>> Candidates;
+	for (int32 SensorIndex = 0; SensorIndex < Sensors.Num(); ++SensorIndex)
+	{
+		AEnemy* Sensor = Sensors[SensorIndex];
+		if (Sensor == nullptr || !Sensor->IsReceptiveToSight()) continue;
+
+		FVector EyeLocation;
+		FRotator EyeRotation;
+		Sensor->GetActorEyesViewPoint(EyeLocation, EyeRotation);
+		const FVector Forward = Sensor->GetActorForwardVector();
+
+		Candidates.Reset();
+		TargetGrid.QueryRadius(EyeLocation, SightRadii[SensorIndex], Candidates);
+
+		for (const int32 Candidate : Candidates)
+		{
+			APawn* Target = PassTargets[Candidate];
+			if (Target == Sensor) continue;
+
+			const FVector ToTarget = (PassTargetLocations[Candidate] - EyeLocation).GetSafeNormal();
+			if (FVector::DotProduct(Forward, ToTarget) < CosPeripheralVisionAngles[SensorIndex]) continue;
+
+			SubmitSightTrace(EyeLocation, Sensor, Target, PassTargetLocations[Candidate]);
+		}
+	}
+}
+
+void UEnemyPerceptionSubsystem::SubmitSightTrace(const FVector& EyeLocation, AEnemy* Sensor, APawn* Target, const FVector& TargetLocation)
+{
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(EnemySight), true, Sensor);
+	Params.AddIgnoredActor(Target);
+
+	FPendingSightTrace& Pending = PendingTraces.AddDefaulted_GetRef();
+	Pending.Handle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Test, EyeLocation, TargetLocation, ECollisionChannel::ECC_Visibility, Params);
+	Pending.Sensor = Sensor;
+	Pending.Target = Target;
+	Pending.SubmitTime = FPlatformTime::Seconds();
+
+	INC_DWORD_STAT(STAT_SlashSightTracesIssued);
+}
+
+void UEnemyPerceptionSubsystem::ConsumeSightTraces()
+{
+	if (PendingTraces.Num() == 0) return;
+
+	UWorld* World = GetWorld();
+	const double Now = FPlatformTime::Seconds();
+	double TotalLatency = 0.0;
+	int32 NumConsumed = 0;
+
+	for (int32 Index = PendingTraces.Num() - 1; Index >= 0; --Index)
+	{
+		const FPendingSightTrace& Pending = PendingTraces[Index];
+
+		FTraceDatum Datum;
+		if (!World->QueryTraceData(Pending.Handle, Datum))
+		{
+			// Still in flight; keep it unless the handle has expired along with its frame's buffer
+			if (!World->IsTraceHandleValid(Pending.Handle, false))
+			{
+				PendingTraces.RemoveAtSwap(Index, 1, false);
+			}
+			continue;
+		}
+
+		TotalLatency += Now - Pending.SubmitTime;
+		++NumConsumed;
+
+		const bool bBlocked = Datum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		SLASH_DRAW_LINE(World, Perception, Datum.Start, Datum.End, bBlocked ? FColor::Red : FColor::Green, CVarEnemyPerceptionInterval.GetValueOnGameThread());
+		AEnemy* Sensor = Pending.Sensor.Get();
+		APawn* Target = Pending.Target.Get();
+
+		// The world may have moved on since submission; PawnSeen re-checks state and tags itself
+		if (!bBlocked && Sensor && Target && Sensor->IsReceptiveToSight())
+		{
+			Sensor->PawnSeen(Target);
+		}
+		PendingTraces.RemoveAtSwap(Index, 1, false);
+	}
+
+	if (NumConsumed > 0)
+	{
+		INC_DWORD_STAT_BY(STAT_SlashSightTracesConsumed, NumConsumed);
+		SET_FLOAT_STAT(STAT_SlashSightTraceLatency, TotalLatency * 1000.0 / NumConsumed);
+	}
+}
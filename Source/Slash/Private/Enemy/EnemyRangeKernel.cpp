@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyRangeKernel.h"
+#include "Slash/Slash.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+	constexpr int32 VectorWidth = 4;
+
+	FORCEINLINE float ToSquaredRadius(const FVector* TargetLocation, double Radius)
+	{
+		// A negative squared radius can never be beaten by a squared distance, so missing targets fall out of the kernel for free
+		return TargetLocation ? static_cast<float>(Radius * Radius) : -1.f;
+	}
+}
+
+void FEnemyRangeBatch::Reset(const FVector& InOrigin, int32 ExpectedNum)
+{
+	Origin = InOrigin;
+	NumQueries = 0;
+
+	const int32 Capacity = Align(ExpectedNum, VectorWidth);
+	for (TArray<float>* Column : { &LocationX, &LocationY, &LocationZ, &CombatTargetX, &CombatTargetY, &CombatTargetZ, &PatrolTargetX, &PatrolTargetY, &PatrolTargetZ, &AttackRadiusSquared, &CombatRadiusSquared, &PatrolRadiusSquared })
+	{
+		Column->Reset(Capacity);
+	}
+	Results.Reset(Capacity);
+}
+
+int32 FEnemyRangeBatch::Add(const FVector& Location, const FVector* CombatTargetLocation, double AttackRadius, double CombatRadius, const FVector* PatrolTargetLocation, double PatrolRadius)
+{
+	const FVector3f Local(Location - Origin);
+	const FVector3f CombatLocal(CombatTargetLocation ? *CombatTargetLocation - Origin : FVector::ZeroVector);
+	const FVector3f PatrolLocal(PatrolTargetLocation ? *PatrolTargetLocation - Origin : FVector::ZeroVector);
+
+	LocationX.Add(Local.X);
+	LocationY.Add(Local.Y);
+	LocationZ.Add(Local.Z);
+	CombatTargetX.Add(CombatLocal.X);
+	CombatTargetY.Add(CombatLocal.Y);
+	CombatTargetZ.Add(CombatLocal.Z);
+	PatrolTargetX.Add(PatrolLocal.X);
+	PatrolTargetY.Add(PatrolLocal.Y);
+	PatrolTargetZ.Add(PatrolLocal.Z);
+	AttackRadiusSquared.Add(ToSquaredRadius(CombatTargetLocation, AttackRadius));
+	CombatRadiusSquared.Add(ToSquaredRadius(CombatTargetLocation, CombatRadius));
+	PatrolRadiusSquared.Add(ToSquaredRadius(PatrolTargetLocation, PatrolRadius));
+
+	return NumQueries++;
+}
+
+void FEnemyRangeBatch::PadToVectorWidth()
+{
+	const int32 PaddedNum = Align(NumQueries, VectorWidth);
+	for (TArray<float>* Column : { &LocationX, &LocationY, &LocationZ, &CombatTargetX, &CombatTargetY, &CombatTargetZ, &PatrolTargetX, &PatrolTargetY, &PatrolTargetZ })
+	{
+		Column->SetNum(PaddedNum, false);
+	}
+	for (TArray<float>* Column : { &AttackRadiusSquared, &CombatRadiusSquared, &PatrolRadiusSquared })
+	{
+		for (int32 Index = Column->Num(); Index < PaddedNum; ++Index)
+		{
+			Column->Add(-1.f);
+		}
+	}
+}
+
+void FEnemyRangeBatch::TrimPadding()
+{
+	for (TArray<float>* Column : { &LocationX, &LocationY, &LocationZ, &CombatTargetX, &CombatTargetY, &CombatTargetZ, &PatrolTargetX, &PatrolTargetY, &PatrolTargetZ, &AttackRadiusSquared, &CombatRadiusSquared, &PatrolRadiusSquared })
+	{
+		Column->SetNum(NumQueries, false);
+	}
+}
+
+void FEnemyRangeBatch::Compute()
+{
+	PadToVectorWidth();
+	Results.SetNumUninitialized(Align(NumQueries, VectorWidth), false);
+
+	const int32 PaddedNum = LocationX.Num();
+	for (int32 Index = 0; Index < PaddedNum; Index += VectorWidth)
+	{
+		const VectorRegister4Float X = VectorLoad(&LocationX[Index]);
+		const VectorRegister4Float Y = VectorLoad(&LocationY[Index]);
+		const VectorRegister4Float Z = VectorLoad(&LocationZ[Index]);
+
+		const VectorRegister4Float CombatDX = VectorSubtract(VectorLoad(&CombatTargetX[Index]), X);
+		const VectorRegister4Float CombatDY = VectorSubtract(VectorLoad(&CombatTargetY[Index]), Y);
+		const VectorRegister4Float CombatDZ = VectorSubtract(VectorLoad(&CombatTargetZ[Index]), Z);
+		const VectorRegister4Float CombatDistSquared = VectorMultiplyAdd(CombatDX, CombatDX, VectorMultiplyAdd(CombatDY, CombatDY, VectorMultiply(CombatDZ, CombatDZ)));
+
+		const VectorRegister4Float PatrolDX = VectorSubtract(VectorLoad(&PatrolTargetX[Index]), X);
+		const VectorRegister4Float PatrolDY = VectorSubtract(VectorLoad(&PatrolTargetY[Index]), Y);
+		const VectorRegister4Float PatrolDZ = VectorSubtract(VectorLoad(&PatrolTargetZ[Index]), Z);
+		const VectorRegister4Float PatrolDistSquared = VectorMultiplyAdd(PatrolDX, PatrolDX, VectorMultiplyAdd(PatrolDY, PatrolDY, VectorMultiply(PatrolDZ, PatrolDZ)));
+
+		const int32 AttackBits = VectorMaskBits(VectorCompareLT(CombatDistSquared, VectorLoad(&AttackRadiusSquared[Index])));
+		const int32 CombatBits = VectorMaskBits(VectorCompareLT(CombatDistSquared, VectorLoad(&CombatRadiusSquared[Index])));
+		const int32 PatrolBits = VectorMaskBits(VectorCompareLT(PatrolDistSquared, VectorLoad(&PatrolRadiusSquared[Index])));
+
+		for (int32 Lane = 0; Lane < VectorWidth; ++Lane)
+		{
+			Results[Index + Lane] = static_cast<EEnemyRangeFlags>(
+				((AttackBits >> Lane) & 1) |
+				(((CombatBits >> Lane) & 1) << 1) |
+				(((PatrolBits >> Lane) & 1) << 2));
+		}
+	}
+
+	Results.SetNum(NumQueries, false);
+	TrimPadding();
+}
+
+void FEnemyRangeBatch::ComputeScalar()
+{
+	Results.SetNumUninitialized(NumQueries, false);
+
+	auto InRange = [](double DistanceSquared, float RadiusSquared)
+	{
+		return RadiusSquared >= 0.f && FMath::Sqrt(DistanceSquared) < FMath::Sqrt(RadiusSquared);
+	};
+
+	for (int32 Index = 0; Index < NumQueries; ++Index)
+	{
+		const FVector Location(LocationX[Index], LocationY[Index], LocationZ[Index]);
+		const double CombatDistSquared = FVector::DistSquared(Location, FVector(CombatTargetX[Index], CombatTargetY[Index], CombatTargetZ[Index]));
+		const double PatrolDistSquared = FVector::DistSquared(Location, FVector(PatrolTargetX[Index], PatrolTargetY[Index], PatrolTargetZ[Index]));
+
+		EEnemyRangeFlags Flags = EEnemyRangeFlags::None;
+		if (InRange(CombatDistSquared, AttackRadiusSquared[Index])) Flags |= EEnemyRangeFlags::InAttackRadius;
+		if (InRange(CombatDistSquared, CombatRadiusSquared[Index])) Flags |= EEnemyRangeFlags::InCombatRadius;
+		if (InRange(PatrolDistSquared, PatrolRadiusSquared[Index])) Flags |= EEnemyRangeFlags::InPatrolRadius;
+		Results[Index] = Flags;
+	}
+}
+
+/**
+ * Slash.AI.BenchmarkRangeKernel [AgentCount ...]
+ * Times the SIMD kernel against the scalar reference at 1k/10k/100k agents (or the given counts).
+ */
+static void BenchmarkRangeKernel(const TArray<FString>& Args)
+{
+	TArray<int32> AgentCounts;
+	for (const FString& Arg : Args)
+	{
+		AgentCounts.Add(FCString::Atoi(*Arg));
+	}
+	if (AgentCounts.Num() == 0)
+	{
+		AgentCounts = { 1000, 10000, 100000 };
+	}
+
+	constexpr int32 Iterations = 50;
+	FRandomStream Stream(1337);
+	FEnemyRangeBatch Batch;
+
+	for (const int32 AgentCount : AgentCounts)
+	{
+		Batch.Reset(FVector::ZeroVector, AgentCount);
+		for (int32 Agent = 0; Agent < AgentCount; ++Agent)
+		{
+			const FVector Location(Stream.FRandRange(-50000.f, 50000.f), Stream.FRandRange(-50000.f, 50000.f), 0.f);
+			const FVector CombatTarget = Location + Stream.VRand() * Stream.FRandRange(0.f, 2000.f);
+			const FVector PatrolTarget = Location + Stream.VRand() * Stream.FRandRange(0.f, 500.f);
+			const bool bHasCombatTarget = Stream.FRand() < 0.5f;
+			Batch.Add(Location, bHasCombatTarget ? &CombatTarget : nullptr, 150.0, 1000.0, &PatrolTarget, 200.0);
+		}
+
+		double ScalarSeconds = 0.0;
+		double SimdSeconds = 0.0;
+		TArray<EEnemyRangeFlags> ScalarResults;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const double ScalarStart = FPlatformTime::Seconds();
+			Batch.ComputeScalar();
+			ScalarSeconds += FPlatformTime::Seconds() - ScalarStart;
+			ScalarResults = Batch.GetResults();
+
+			const double SimdStart = FPlatformTime::Seconds();
+			Batch.Compute();
+			SimdSeconds += FPlatformTime::Seconds() - SimdStart;
+		}
+
+		int32 Mismatches = 0;
+		for (int32 Agent = 0; Agent < AgentCount; ++Agent)
+		{
+			Mismatches += ScalarResults[Agent] != Batch.GetFlags(Agent) ? 1 : 0;
+		}
+
+		UE_LOG(LogSlash, Display, TEXT("RangeKernel %6d agents: scalar %.3f ms, simd %.3f ms (%.2fx), %d mismatches"),
+			AgentCount,
+			ScalarSeconds * 1000.0 / Iterations,
+			SimdSeconds * 1000.0 / Iterations,
+			SimdSeconds > 0.0 ? ScalarSeconds / SimdSeconds : 0.0,
+			Mismatches);
+	}
+}
+
+static FAutoConsoleCommand BenchmarkRangeKernelCommand(
+	TEXT("Slash.AI.BenchmarkRangeKernel"),
+	TEXT("Benchmarks the batched enemy range kernel. Usage: Slash.AI.BenchmarkRangeKernel [AgentCount ...]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkRangeKernel));
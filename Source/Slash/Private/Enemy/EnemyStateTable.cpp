@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/EnemyStateTable.h"
+
+// The table is pure data, so its behaviour is checked here at compile time rather than in a running world.
+namespace EnemyStateTable
+{
+	constexpr EEnemyRangeFlags InAttack = EEnemyRangeFlags::InAttackRadius | EEnemyRangeFlags::InCombatRadius;
+	constexpr EEnemyRangeFlags InCombat = EEnemyRangeFlags::InCombatRadius;
+	constexpr EEnemyRangeFlags OutOfRange = EEnemyRangeFlags::None;
+
+	constexpr bool RowIsEmpty(EEnemyState State)
+	{
+		for (int32 Mask = 0; Mask < NumConditionMasks; ++Mask)
+		{
+			if (Table.Actions[static_cast<uint8>(State)][Mask] != EEnemyActions::None) return false;
+		}
+		return true;
+	}
+
+	static_assert(static_cast<int32>(EEnemyRangeFlags::InAttackRadius | EEnemyRangeFlags::InCombatRadius | EEnemyRangeFlags::InPatrolRadius) == NumConditionMasks - 1,
+		"Every EEnemyRangeFlags combination needs a column");
+
+	static_assert(RowIsEmpty(EEnemyState::EES_Dead), "Dead enemies never act");
+
+	static_assert(Lookup(EEnemyState::EES_Patrolling, EEnemyRangeFlags::InPatrolRadius) == EEnemyActions::PickPatrolTarget, "Reaching a patrol point picks the next one");
+	static_assert(Lookup(EEnemyState::EES_Patrolling, InAttack) == EEnemyActions::None, "Patrollers ignore combat ranges until they see a target");
+
+	static_assert(Lookup(EEnemyState::EES_Chasing, InCombat) == EEnemyActions::None, "Chasers keep chasing");
+	static_assert(Lookup(EEnemyState::EES_Chasing, InAttack) == EEnemyActions::StartAttackTimer, "Chasers attack once in reach");
+	static_assert(Lookup(EEnemyState::EES_Chasing, OutOfRange) == (EEnemyActions::ClearAttackTimer | EEnemyActions::LoseInterest | EEnemyActions::StartPatrolling), "Chasers give up outside the combat radius");
+
+	static_assert(Lookup(EEnemyState::EES_Attacking, InAttack) == EEnemyActions::None, "A pending attack isn't restarted");
+	static_assert(Lookup(EEnemyState::EES_Attacking, InCombat) == (EEnemyActions::ClearAttackTimer | EEnemyActions::StartChasing), "Attackers chase a target that backs off");
+
+	static_assert(Lookup(EEnemyState::EES_Engaged, InAttack) == EEnemyActions::None, "Swings aren't interrupted");
+	static_assert(Lookup(EEnemyState::EES_Engaged, InCombat) == EEnemyActions::ClearAttackTimer, "Engaged enemies finish the swing before chasing");
+	static_assert(Lookup(EEnemyState::EES_Engaged, OutOfRange) == (EEnemyActions::ClearAttackTimer | EEnemyActions::LoseInterest), "Engaged enemies finish the swing before patrolling");
+
+	static_assert(Lookup(EEnemyState::EES_Unoccupied, InAttack) == EEnemyActions::StartAttackTimer, "After an attack, attack again when still in reach");
+	static_assert(Lookup(EEnemyState::EES_Unoccupied, InCombat) == (EEnemyActions::ClearAttackTimer | EEnemyActions::StartChasing), "After an attack, chase when out of reach");
+}
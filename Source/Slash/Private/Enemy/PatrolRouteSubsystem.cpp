@@ -0,0 +1,134 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy/PatrolRouteSubsystem.h"
+#include "Random/SlashRng.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Slash/Slash.h"
+
+void UPatrolRouteSubsystem::Deinitialize()
+{
+	Waypoints.Empty();
+	WaypointIndices.Empty();
+	Routes.Empty();
+	RouteWaypoints.Empty();
+	RouteLookup.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UPatrolRouteSubsystem::RegisterRoute(TArrayView<AActor* const> InWaypoints)
+{
+	TArray<int32, TInlineAllocator<16>> SortedWaypoints;
+	for (AActor* Waypoint : InWaypoints)
+	{
+		if (IsValid(Waypoint))
+		{
+			SortedWaypoints.AddUnique(FindOrAddWaypoint(Waypoint));
+		}
+	}
+	SortedWaypoints.Sort();
+
+	uint32 Hash = 0;
+	for (const int32 WaypointIndex : SortedWaypoints)
+	{
+		Hash = HashCombineFast(Hash, ::GetTypeHash(WaypointIndex));
+	}
+
+	const int32 Existing = FindRoute(SortedWaypoints, Hash);
+	if (Existing != INDEX_NONE) return Existing;
+
+	FPatrolRoute& Route = Routes.AddDefaulted_GetRef();
+	Route.FirstSlot = RouteWaypoints.Num();
+	Route.NumSlots = SortedWaypoints.Num();
+	RouteWaypoints.Append(SortedWaypoints);
+
+	const int32 RouteIndex = Routes.Num() - 1;
+	RouteLookup.Add(Hash, RouteIndex);
+	return RouteIndex;
+}
+
+int32 UPatrolRouteSubsystem::FindOrAddWaypoint(AActor* Waypoint)
+{
+	if (const int32* Existing = WaypointIndices.Find(Waypoint))
+	{
+		return *Existing;
+	}
+	const int32 Index = Waypoints.Add(Waypoint);
+	WaypointIndices.Add(Waypoint, Index);
+	return Index;
+}
+
+int32 UPatrolRouteSubsystem::FindRoute(TArrayView<const int32> SortedWaypoints, uint32 Hash) const
+{
+	TArray<int32, TInlineAllocator<4>> Candidates;
+	RouteLookup.MultiFind(Hash, Candidates);
+	for (const int32 Candidate : Candidates)
+	{
+		const FPatrolRoute& Route = Routes[Candidate];
+		if (Route.NumSlots == SortedWaypoints.Num() &&
+			(Route.NumSlots == 0 || FMemory::Memcmp(&RouteWaypoints[Route.FirstSlot], SortedWaypoints.GetData(), Route.NumSlots * sizeof(int32)) == 0))
+		{
+			return Candidate;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 UPatrolRouteSubsystem::FindSlot(int32 Route, const AActor* Waypoint) const
+{
+	const int32* WaypointIndex = Waypoint ? WaypointIndices.Find(Waypoint) : nullptr;
+	if (WaypointIndex == nullptr || !Routes.IsValidIndex(Route)) return INDEX_NONE;
+
+	const FPatrolRoute& PatrolRoute = Routes[Route];
+	for (int32 Slot = 0; Slot < PatrolRoute.NumSlots; ++Slot)
+	{
+		if (RouteWaypoints[PatrolRoute.FirstSlot + Slot] == *WaypointIndex)
+		{
+			return Slot;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 UPatrolRouteSubsystem::PickNextSlot(int32 Route, int32 CurrentSlot, FSlashRng& Rng) const
+{
+	if (!Routes.IsValidIndex(Route)) return INDEX_NONE;
+
+	const FPatrolRoute& PatrolRoute = Routes[Route];
+	if (CurrentSlot < 0 || CurrentSlot >= PatrolRoute.NumSlots)
+	{
+		return PatrolRoute.NumSlots > 0 ? Rng.RandHelper(PatrolRoute.NumSlots) : INDEX_NONE;
+	}
+
+	if (PatrolRoute.NumSlots <= 1) return INDEX_NONE;
+
+	// Draw from the other NumSlots - 1 slots by skipping over the current one
+	const int32 Pick = Rng.RandHelper(PatrolRoute.NumSlots - 1);
+	return Pick < CurrentSlot ? Pick : Pick + 1;
+}
+
+AActor* UPatrolRouteSubsystem::GetWaypoint(int32 Route, int32 Slot) const
+{
+	if (!Routes.IsValidIndex(Route) || Slot < 0 || Slot >= Routes[Route].NumSlots) return nullptr;
+
+	return Waypoints[RouteWaypoints[Routes[Route].FirstSlot + Slot]];
+}
+
+void UPatrolRouteSubsystem::DumpStats() const
+{
+	UE_LOG(LogSlash, Display, TEXT("Patrol routes: %d routes over %d waypoints, %d slots (%d bytes)"),
+		Routes.Num(), Waypoints.Num(), RouteWaypoints.Num(),
+		static_cast<int32>(Routes.GetAllocatedSize() + RouteWaypoints.GetAllocatedSize()));
+}
+
+static FAutoConsoleCommandWithWorld DumpPatrolRoutesCommand(
+	TEXT("Slash.AI.DumpPatrolRoutes"),
+	TEXT("Logs how many patrol routes and waypoints the world's enemies share."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UPatrolRouteSubsystem* PatrolRoutes = World ? World->GetSubsystem<UPatrolRouteSubsystem>() : nullptr)
+		{
+			PatrolRoutes->DumpStats();
+		}
+	}));
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUD/HealthBarSubsystem.h"
+#include "HUD/SHealthBarLayer.h"
+#include "HUD/HealthBar.h"
+#include "Components/ProgressBar.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<float> CVarHealthBarMaxDistance(
+	TEXT("Slash.HUD.HealthBarMaxDistance"),
+	3000.f,
+	TEXT("Enemy health bars farther than this from the camera are not drawn."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Health Bars Drawn"), STAT_SlashHealthBarsDrawn, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("HUD Health Bar Layer Update"), STAT_SlashHealthBarUpdate, STATGROUP_Slash);
+
+/** Keeps a bar whose anchor is just off the edge drawn until it has fully left the screen. */
+static constexpr float HealthBarScreenMargin = 64.f;
+
+void UHealthBarSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Project after the camera managers have updated so the bars don't trail the view by a frame
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UHealthBarSubsystem::UpdateLayer);
+}
+
+void UHealthBarSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	if (Layer.IsValid())
+	{
+		if (UGameViewportClient* GameViewport = GetWorld()->GetGameViewport())
+		{
+			GameViewport->RemoveViewportWidgetContent(Layer.ToSharedRef());
+		}
+		Layer.Reset();
+	}
+	Bars.Empty();
+	NumVisibleBars = 0;
+	bStyleSet = false;
+
+	Super::Deinitialize();
+}
+
+int32 UHealthBarSubsystem::AddBar(AActor* Actor, float HeightOffset)
+{
+	FHealthBarEntry Entry;
+	Entry.Actor = Actor;
+	Entry.HeightOffset = HeightOffset;
+	return Bars.Add(MoveTemp(Entry));
+}
+
+void UHealthBarSubsystem::RemoveBar(int32 Handle)
+{
+	if (!Bars.IsValidIndex(Handle)) return;
+
+	if (Bars[Handle].bVisible)
+	{
+		--NumVisibleBars;
+	}
+	Bars.RemoveAt(Handle);
+}
+
+void UHealthBarSubsystem::SetBarPercent(int32 Handle, float Percent)
+{
+	if (Bars.IsValidIndex(Handle))
+	{
+		Bars[Handle].Percent = Percent;
+	}
+}
+
+void UHealthBarSubsystem::SetBarVisible(int32 Handle, bool bVisible)
+{
+	if (!Bars.IsValidIndex(Handle) || Bars[Handle].bVisible == bVisible) return;
+
+	Bars[Handle].bVisible = bVisible;
+	NumVisibleBars += bVisible ? 1 : -1;
+}
+
+void UHealthBarSubsystem::SetBarStyle(TSubclassOf<UHealthBar> WidgetClass, const FVector2D& Size)
+{
+	if (bStyleSet || Layer.IsValid()) return;
+
+	bStyleSet = true;
+	Style.Size = Size;
+	if (WidgetClass == nullptr) return;
+
+	// The progress bar only exists in the widget tree, so build one instance to read it and let it be collected
+	const UHealthBar* Widget = CreateWidget<UHealthBar>(GetWorld(), WidgetClass);
+	if (Widget && Widget->HealthBar)
+	{
+		const FProgressBarStyle& BarStyle = Widget->HealthBar->GetWidgetStyle();
+		Style.FillColor = Widget->HealthBar->GetFillColorAndOpacity() * BarStyle.FillImage.TintColor.GetSpecifiedColor();
+		Style.BackgroundColor = BarStyle.BackgroundImage.TintColor.GetSpecifiedColor();
+	}
+}
+
+bool UHealthBarSubsystem::EnsureLayer()
+{
+	if (Layer.IsValid()) return true;
+
+	UGameViewportClient* GameViewport = GetWorld()->GetGameViewport();
+	if (GameViewport == nullptr) return false;
+
+	// Below the player overlay, which UMG adds at Z-order 0
+	Layer = SNew(SHealthBarLayer).Style(Style);
+	GameViewport->AddViewportWidgetContent(Layer.ToSharedRef(), -1);
+	return true;
+}
+
+void UHealthBarSubsystem::UpdateLayer(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+	SLASH_SCOPE_TIMER("HealthBars");
+	SCOPE_CYCLE_COUNTER(STAT_SlashHealthBarUpdate);
+
+	DrawData.Reset();
+	APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (NumVisibleBars > 0 && PlayerController && EnsureLayer())
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		int32 ViewportX = 0;
+		int32 ViewportY = 0;
+		PlayerController->GetViewportSize(ViewportX, ViewportY);
+		const float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(World);
+		const float InvViewportScale = ViewportScale > 0.f ? 1.f / ViewportScale : 1.f;
+		const double MaxDistanceSquared = FMath::Square(CVarHealthBarMaxDistance.GetValueOnGameThread());
+
+		for (const FHealthBarEntry& Entry : Bars)
+		{
+			if (!Entry.bVisible) continue;
+
+			const AActor* Actor = Entry.Actor.Get();
+			if (Actor == nullptr) continue;
+
+			const FVector WorldLocation = Actor->GetActorLocation() + FVector(0.f, 0.f, Entry.HeightOffset);
+			if (FVector::DistSquared(WorldLocation, ViewLocation) > MaxDistanceSquared) continue;
+
+			FVector2D ScreenLocation;
+			if (!UGameplayStatics::ProjectWorldToScreen(PlayerController, WorldLocation, ScreenLocation, true)) continue;
+			if (ScreenLocation.X < -HealthBarScreenMargin || ScreenLocation.Y < -HealthBarScreenMargin
+				|| ScreenLocation.X > ViewportX + HealthBarScreenMargin || ScreenLocation.Y > ViewportY + HealthBarScreenMargin) continue;
+
+			FHealthBarDrawData& Bar = DrawData.AddDefaulted_GetRef();
+			Bar.Position = FVector2f(ScreenLocation * InvViewportScale);
+			Bar.Percent = Entry.Percent;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SlashHealthBarsDrawn, DrawData.Num());
+	if (Layer.IsValid())
+	{
+		Layer->SetBars(DrawData);
+	}
+}
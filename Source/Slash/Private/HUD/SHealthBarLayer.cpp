@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "HUD/SHealthBarLayer.h"
+#include "Rendering/DrawElements.h"
+
+void SHealthBarLayer::Construct(const FArguments& InArgs)
+{
+	Style = InArgs._Style;
+	BarSize = FVector2f(Style.Size);
+
+	SetVisibility(EVisibility::HitTestInvisible);
+}
+
+void SHealthBarLayer::SetBars(TArray<FHealthBarDrawData>& InOutBars)
+{
+	if (Bars.Num() == 0 && InOutBars.Num() == 0) return;
+
+	Swap(Bars, InOutBars);
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+int32 SHealthBarLayer::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	const int32 BackgroundLayer = LayerId;
+	const int32 FillLayer = LayerId + 1;
+	const FVector2f HalfSize = BarSize * 0.5f;
+
+	for (const FHealthBarDrawData& Bar : Bars)
+	{
+		const FVector2f TopLeft = Bar.Position - HalfSize;
+		FSlateDrawElement::MakeBox(OutDrawElements, BackgroundLayer,
+			AllottedGeometry.ToPaintGeometry(BarSize, FSlateLayoutTransform(TopLeft)),
+			&Brush, ESlateDrawEffect::None, Style.BackgroundColor);
+
+		if (Bar.Percent > 0.f)
+		{
+			const FVector2f FillSize(BarSize.X * FMath::Min(Bar.Percent, 1.f), BarSize.Y);
+			FSlateDrawElement::MakeBox(OutDrawElements, FillLayer,
+				AllottedGeometry.ToPaintGeometry(FillSize, FSlateLayoutTransform(TopLeft)),
+				&Brush, ESlateDrawEffect::None, Style.FillColor);
+		}
+	}
+	return FillLayer;
+}
+
+FVector2D SHealthBarLayer::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Fills whatever the viewport gives it; bars are positioned absolutely
+	return FVector2D::ZeroVector;
+}
@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Brushes/SlateColorBrush.h"
+#include "HUD/HealthBarSubsystem.h"
+
+/**
+ * Screen-space layer that draws every visible enemy health bar from a packed array.
+ * All backgrounds go out on one layer and all fills on the next, so Slate batches
+ * them into two draw calls no matter how many bars are on screen.
+ */
+class SHealthBarLayer : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SHealthBarLayer)
+		{}
+		SLATE_ARGUMENT(FHealthBarStyle, Style)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** Swaps in this frame's bars and repaints the layer, unless both frames are empty. */
+	void SetBars(TArray<FHealthBarDrawData>& InOutBars);
+
+	/** SWidget */
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	TArray<FHealthBarDrawData> Bars;
+	FVector2f BarSize;
+	FHealthBarStyle Style;
+	FSlateColorBrush Brush = FSlateColorBrush(FLinearColor::White);
+};
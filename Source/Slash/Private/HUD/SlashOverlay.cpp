@@ -4,40 +4,175 @@
 #include "HUD/SlashOverlay.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
+#include "Components/AttributeComponent.h"
+#include "Engine/World.h"
+#include "Slash/SlashStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("HUD Overlay Flush"), STAT_SlashOverlayFlush, STATGROUP_Slash);
+
+/** Progress bar changes smaller than this are below a pixel on any sensible bar width. */
+static constexpr float HUDPercentTolerance = 0.001f;
+
+void USlashOverlay::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// Nothing on the overlay is interactive; skip it during hit testing
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void USlashOverlay::NativeDestruct()
+{
+	UnbindAttributes();
+	if (FlushHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(FlushHandle);
+		FlushHandle.Reset();
+	}
+	Super::NativeDestruct();
+}
+
+void USlashOverlay::BindAttributes(UAttributeComponent* InAttributes)
+{
+	UnbindAttributes();
+	if (InAttributes == nullptr) return;
+
+	BoundAttributes = InAttributes;
+	HealthChangedHandle = InAttributes->OnHealthChanged.AddUObject(this, &USlashOverlay::HandleHealthChanged);
+	StaminaChangedHandle = InAttributes->OnStaminaChanged.AddUObject(this, &USlashOverlay::HandleStaminaChanged);
+	GoldChangedHandle = InAttributes->OnGoldChanged.AddUObject(this, &USlashOverlay::SetCoinCount);
+	SoulsChangedHandle = InAttributes->OnSoulsChanged.AddUObject(this, &USlashOverlay::SetSoulsCount);
+
+	SetHealthBarPercent(InAttributes->GetHealthPercent());
+	SetStaminaBarPercent(InAttributes->GetStaminaPercent());
+	SetCoinCount(InAttributes->GetGold());
+	SetSoulsCount(InAttributes->GetSouls());
+	if (InAttributes->IsRegeneratingStamina())
+	{
+		MarkDirty(DF_Stamina);
+	}
+}
+
+void USlashOverlay::UnbindAttributes()
+{
+	if (UAttributeComponent* Attributes = BoundAttributes.Get())
+	{
+		Attributes->OnHealthChanged.Remove(HealthChangedHandle);
+		Attributes->OnStaminaChanged.Remove(StaminaChangedHandle);
+		Attributes->OnGoldChanged.Remove(GoldChangedHandle);
+		Attributes->OnSoulsChanged.Remove(SoulsChangedHandle);
+	}
+	BoundAttributes.Reset();
+}
+
+void USlashOverlay::HandleHealthChanged(float NewValue, float MaxValue)
+{
+	SetHealthBarPercent(MaxValue > 0.f ? NewValue / MaxValue : 0.f);
+}
+
+void USlashOverlay::HandleStaminaChanged(float NewValue, float MaxValue)
+{
+	SetStaminaBarPercent(MaxValue > 0.f ? NewValue / MaxValue : 0.f);
+
+	// Spending stamina starts a regen; keep the end-of-frame flush alive to sample it
+	const UAttributeComponent* Attributes = BoundAttributes.Get();
+	if (Attributes && Attributes->IsRegeneratingStamina())
+	{
+		MarkDirty(DF_Stamina);
+	}
+}
 
 void USlashOverlay::SetHealthBarPercent(float percent)
 {
-	if(HealthProgressBar)
+	PendingHealthPercent = percent;
+	if (!FMath::IsNearlyEqual(percent, ShownHealthPercent, HUDPercentTolerance))
 	{
-		HealthProgressBar->SetPercent(percent);
+		MarkDirty(DF_Health);
 	}
 }
 
 void USlashOverlay::SetStaminaBarPercent(float percent)
 {
-	if (StaminaProgressBar)
+	PendingStaminaPercent = percent;
+	if (!FMath::IsNearlyEqual(percent, ShownStaminaPercent, HUDPercentTolerance))
 	{
-		StaminaProgressBar->SetPercent(percent);
+		MarkDirty(DF_Stamina);
 	}
 }
 
 void USlashOverlay::SetCoinCount(int32 count)
 {
-	if (CoinCountText)
+	PendingCoins = count;
+	if (count != ShownCoins)
 	{
-		CoinCountText->SetText(IntToFText(count));
+		MarkDirty(DF_Coins);
 	}
 }
 
 FText USlashOverlay::IntToFText(const int32& count)
 {
-	return FText::FromString(FString::Printf(TEXT("%d"), count));
+	return FText::AsNumber(count, &FNumberFormattingOptions::DefaultNoGrouping());
 }
 
 void USlashOverlay::SetSoulsCount(int32 count)
 {
-	if (SoulsCountText)
+	PendingSouls = count;
+	if (count != ShownSouls)
+	{
+		MarkDirty(DF_Souls);
+	}
+}
+
+void USlashOverlay::MarkDirty(EDirtyField Field)
+{
+	DirtyFields |= Field;
+
+	// Only listen for the end of the frame while there is something to flush
+	if (!FlushHandle.IsValid())
+	{
+		FlushHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USlashOverlay::FlushPendingChanges);
+	}
+}
+
+void USlashOverlay::FlushPendingChanges(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld()) return;
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashOverlayFlush);
+
+	// Regen isn't published per frame; sample it here while it runs
+	const UAttributeComponent* Attributes = BoundAttributes.Get();
+	const bool bStaminaRegenerating = Attributes && Attributes->IsRegeneratingStamina();
+	if (bStaminaRegenerating)
+	{
+		PendingStaminaPercent = Attributes->GetStaminaPercent();
+		DirtyFields |= DF_Stamina;
+	}
+	else
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(FlushHandle);
+		FlushHandle.Reset();
+	}
+
+	// Re-check against what is shown: a value can change and change back within one frame
+	if ((DirtyFields & DF_Health) && HealthProgressBar && !FMath::IsNearlyEqual(PendingHealthPercent, ShownHealthPercent, HUDPercentTolerance))
+	{
+		HealthProgressBar->SetPercent(PendingHealthPercent);
+		ShownHealthPercent = PendingHealthPercent;
+	}
+	if ((DirtyFields & DF_Stamina) && StaminaProgressBar && !FMath::IsNearlyEqual(PendingStaminaPercent, ShownStaminaPercent, HUDPercentTolerance))
+	{
+		StaminaProgressBar->SetPercent(PendingStaminaPercent);
+		ShownStaminaPercent = PendingStaminaPercent;
+	}
+	if ((DirtyFields & DF_Coins) && CoinCountText && PendingCoins != ShownCoins)
+	{
+		CoinCountText->SetText(IntToFText(PendingCoins));
+		ShownCoins = PendingCoins;
+	}
+	if ((DirtyFields & DF_Souls) && SoulsCountText && PendingSouls != ShownSouls)
 	{
-		SoulsCountText->SetText(IntToFText(count));
+		SoulsCountText->SetText(IntToFText(PendingSouls));
+		ShownSouls = PendingSouls;
 	}
+	DirtyFields = 0;
 }
@@ -0,0 +1,12 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Interfaces/PoolableInterface.h"
+
+void IPoolableInterface::OnAcquiredFromPool()
+{
+}
+
+void IPoolableInterface::OnReturnedToPool()
+{
+}
@@ -1,17 +1,18 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Items/Item.h"
-#include "DrawDebugHelpers.h"
-#include "Slash/DebugMacros.h"
 #include "Components/SphereComponent.h"
 #include "Kismet/GameplayStatics.h" 
 #include "Interfaces/PickupInterface.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
+#include "Items/ItemAnimationSubsystem.h"
+#include "Significance/SlashSignificanceSubsystem.h"
 
 AItem::AItem()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Hovering is animated in batch by UItemAnimationSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 
 	ItemMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ItemMeshComponent"));
 	SetRootComponent(ItemMesh);
@@ -34,6 +35,97 @@ void AItem::BeginPlay()
 	Super::BeginPlay();
 	Sphere->OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereOverlap);
 	Sphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
+
+	if (ItemState == EItemState::EIS_Hovering)
+	{
+		StartHovering();
+	}
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopHovering();
+	Super::EndPlay(EndPlayReason);
+}
+
+void AItem::StartHovering()
+{
+	if (ItemAnimation == nullptr)
+	{
+		UWorld* World = GetWorld();
+		ItemAnimation = World ? World->GetSubsystem<UItemAnimationSubsystem>() : nullptr;
+	}
+	if (ItemAnimation)
+	{
+		ItemAnimation->RegisterItem(this, RunningTime, Amplitude, TimeConstant, ForwardSpeed);
+	}
+
+	UWorld* World = GetWorld();
+	if (USlashSignificanceSubsystem* Significance = World ? World->GetSubsystem<USlashSignificanceSubsystem>() : nullptr)
+	{
+		Significance->Register(ItemMesh, ESignificanceCategory::Item);
+	}
+}
+
+void AItem::StopHovering()
+{
+	if (ItemAnimation)
+	{
+		ItemAnimation->UnregisterItem(this);
+	}
+
+	UWorld* World = GetWorld();
+	if (USlashSignificanceSubsystem* Significance = World ? World->GetSubsystem<USlashSignificanceSubsystem>() : nullptr)
+	{
+		Significance->Unregister(ItemMesh);
+	}
+}
+
+void AItem::SetSignificance(ESignificanceBucket Bucket)
+{
+	// The embers are pure decoration; stop simulating them once the item is far away or out of view
+	const bool bWantsEffect = ItemState == EItemState::EIS_Hovering && Bucket <= ESignificanceBucket::Medium;
+	if (ItemEffect && bWantsEffect != ItemEffect->IsActive())
+	{
+		if (bWantsEffect)
+		{
+			ItemEffect->Activate();
+		}
+		else
+		{
+			ItemEffect->Deactivate();
+		}
+	}
+}
+
+void AItem::SetHoverDescent(float TargetZ, float Speed)
+{
+	if (ItemAnimation)
+	{
+		ItemAnimation->SetDescent(this, TargetZ, Speed);
+	}
+}
+
+void AItem::OnAcquiredFromPool()
+{
+	RunningTime = 0.f;
+	if (ItemState == EItemState::EIS_Hovering)
+	{
+		StartHovering();
+		if (ItemEffect)
+		{
+			ItemEffect->Activate(true);
+		}
+	}
+}
+
+void AItem::OnReturnedToPool()
+{
+	StopHovering();
+	if (ItemEffect)
+	{
+		ItemEffect->Deactivate();
+	}
 }
 
 float AItem::TransformedSin()
@@ -70,15 +162,3 @@ void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor*
 		PickupInterface->SetOverlappingItem(nullptr);
 	}
 }
-
-void AItem::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-	RunningTime += DeltaTime;
-
-	if (ItemState == EItemState::EIS_Hovering)
-	{
-		AddActorWorldOffset(FVector(0.f, 0.f, TransformedSin()));
-		AddActorWorldRotation(FRotator(0.f, ForwardSpeed, 0.f));
-	}
-}
\ No newline at end of file
@@ -0,0 +1,173 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Items/ItemAnimationSubsystem.h"
+#include "Items/Item.h"
+#include "Math/VectorRegister.h"
+#include "Slash/SlashStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hovering Items"), STAT_SlashHoveringItems, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hovering Items Moved"), STAT_SlashHoveringItemsMoved, STATGROUP_Slash);
+
+static TAutoConsoleVariable<float> CVarItemAnimationRenderTimeout(
+	TEXT("Slash.Items.HoverRenderTimeout"),
+	0.2f,
+	TEXT("Seconds since an item was last rendered before its hover motion stops being applied."),
+	ECVF_Default);
+
+void UItemAnimationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("ItemAnimation");
+
+	const int32 NumItems = Items.Num();
+	if (NumItems == 0) return;
+
+	const int32 NumPadded = Align(NumItems, 4);
+	Phases.SetNumUninitialized(NumPadded, false);
+	Sines.SetNumUninitialized(NumPadded, false);
+
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		RunningTimes[Index] += DeltaTime;
+		Phases[Index] = RunningTimes[Index] * TimeConstants[Index];
+	}
+	for (int32 Index = NumItems; Index < NumPadded; ++Index)
+	{
+		Phases[Index] = 0.f;
+	}
+
+	for (int32 Index = 0; Index < NumPadded; Index += 4)
+	{
+		VectorStore(VectorSin(VectorLoad(&Phases[Index])), &Sines[Index]);
+	}
+
+	const float RenderTimeout = CVarItemAnimationRenderTimeout.GetValueOnGameThread();
+	int32 NumMoved = 0;
+
+	bAnimating = true;
+	for (int32 Index = 0; Index < NumItems; ++Index)
+	{
+		AItem* Item = Items[Index];
+		if (Item == nullptr) continue;
+
+		Item->SetRunningTime(RunningTimes[Index]);
+
+		// A sinking soul still has to land while off screen
+		if (DescentSpeeds[Index] > 0.f && RestZs[Index] > DescentTargets[Index])
+		{
+			RestZs[Index] = FMath::Max(RestZs[Index] - DescentSpeeds[Index] * DeltaTime, DescentTargets[Index]);
+		}
+
+		// The bob is absolute around the rest height, so skipping off-screen frames loses nothing
+		if (!Item->WasRecentlyRendered(RenderTimeout)) continue;
+
+		FVector Location = Item->GetActorLocation();
+		Location.Z = RestZs[Index] + Amplitudes[Index] * Sines[Index];
+
+		const FQuat Spin(FVector::UpVector, FMath::DegreesToRadians(ForwardSpeeds[Index]));
+		Item->SetActorLocationAndRotation(Location, Spin * Item->GetActorQuat());
+		++NumMoved;
+	}
+	bAnimating = false;
+
+	for (AItem* Item : PendingRemovals)
+	{
+		UnregisterItem(Item);
+	}
+	PendingRemovals.Reset();
+
+	SET_DWORD_STAT(STAT_SlashHoveringItems, GetNumItems());
+	SET_DWORD_STAT(STAT_SlashHoveringItemsMoved, NumMoved);
+}
+
+TStatId UItemAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UItemAnimationSubsystem, STATGROUP_Tickables);
+}
+
+void UItemAnimationSubsystem::Deinitialize()
+{
+	for (AItem* Item : Items)
+	{
+		if (Item)
+		{
+			Item->SetAnimationHandle(INDEX_NONE);
+		}
+	}
+	Items.Empty();
+	RunningTimes.Empty();
+	TimeConstants.Empty();
+	Amplitudes.Empty();
+	RestZs.Empty();
+	ForwardSpeeds.Empty();
+	DescentTargets.Empty();
+	DescentSpeeds.Empty();
+	PendingRemovals.Empty();
+
+	Super::Deinitialize();
+}
+
+void UItemAnimationSubsystem::RegisterItem(AItem* Item, float RunningTime, float Amplitude, float TimeConstant, float ForwardSpeed)
+{
+	if (Item == nullptr) return;
+
+	// Re-registering an item whose removal is still pending just cancels the removal
+	if (PendingRemovals.RemoveSingleSwap(Item, false) > 0) return;
+	if (Item->GetAnimationHandle() != INDEX_NONE) return;
+
+	const int32 Index = Items.Add(Item);
+	RunningTimes.Add(RunningTime);
+	TimeConstants.Add(TimeConstant);
+	// AItem::Amplitude was tuned as a per-frame offset summed at 60 fps, which peaks at Amplitude / (TimeConstant * dt);
+	// keep that height now that the bob is absolute and no longer depends on frame rate
+	static constexpr float TunedDeltaTime = 1.f / 60.f;
+	Amplitudes.Add(FMath::IsNearlyZero(TimeConstant) ? Amplitude : Amplitude / (FMath::Abs(TimeConstant) * TunedDeltaTime));
+	RestZs.Add(Item->GetActorLocation().Z);
+	ForwardSpeeds.Add(ForwardSpeed);
+	DescentTargets.Add(0.f);
+	DescentSpeeds.Add(0.f);
+	Item->SetAnimationHandle(Index);
+}
+
+void UItemAnimationSubsystem::UnregisterItem(AItem* Item)
+{
+	if (Item == nullptr) return;
+
+	const int32 Index = Item->GetAnimationHandle();
+	if (!Items.IsValidIndex(Index) || Items[Index] != Item) return;
+
+	if (bAnimating)
+	{
+		PendingRemovals.AddUnique(Item);
+		return;
+	}
+	RemoveAt(Index);
+}
+
+void UItemAnimationSubsystem::SetDescent(const AItem* Item, float TargetZ, float Speed)
+{
+	const int32 Index = Item ? Item->GetAnimationHandle() : INDEX_NONE;
+	if (!Items.IsValidIndex(Index) || Items[Index] != Item) return;
+
+	DescentTargets[Index] = TargetZ;
+	DescentSpeeds[Index] = Speed;
+}
+
+void UItemAnimationSubsystem::RemoveAt(int32 Index)
+{
+	Items[Index]->SetAnimationHandle(INDEX_NONE);
+
+	Items.RemoveAtSwap(Index, 1, false);
+	RunningTimes.RemoveAtSwap(Index, 1, false);
+	TimeConstants.RemoveAtSwap(Index, 1, false);
+	Amplitudes.RemoveAtSwap(Index, 1, false);
+	RestZs.RemoveAtSwap(Index, 1, false);
+	ForwardSpeeds.RemoveAtSwap(Index, 1, false);
+	DescentTargets.RemoveAtSwap(Index, 1, false);
+	DescentSpeeds.RemoveAtSwap(Index, 1, false);
+
+	if (Items.IsValidIndex(Index) && Items[Index])
+	{
+		Items[Index]->SetAnimationHandle(Index);
+	}
+}
@@ -5,38 +5,43 @@
 #include "Interfaces/PickupInterface.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "NiagaraFunctionLibrary.h"
+#include "Pooling/ActorPoolSubsystem.h"
+#include "Slash/SlashStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Soul BoxTrace"), STAT_SlashSoulBoxTrace, STATGROUP_Slash);
 
 ASoul::ASoul()
 {	
-	PrimaryActorTick.bCanEverTick = true;
+	// Sinking to DesiredZ runs alongside the hover motion in UItemAnimationSubsystem
+	PrimaryActorTick.bCanEverTick = false;
 }
 
-void ASoul::Tick(float DeltaTime)
+void ASoul::OnAcquiredFromPool()
 {
-	Super::Tick(DeltaTime);
+	Super::OnAcquiredFromPool();
 
-	MoveToDesiredZ(DeltaTime);
+	// BeginPlay doesn't run again for a pooled soul, so settle above the ground at the new drop point
+	UpdateDesiredZ();
 }
 
-void ASoul::MoveToDesiredZ(float DeltaTime)
+void ASoul::BeginPlay()
 {
-	if (GetActorLocation().Z > DesiredZ)
-	{
-		AddActorWorldOffset(FVector(0.f, 0.f, -15.f * DeltaTime));
-	}
+	Super::BeginPlay();
+	UpdateDesiredZ();
 }
 
-void ASoul::BeginPlay()
+void ASoul::UpdateDesiredZ()
 {
-	Super::BeginPlay();
 	FHitResult BoxHit;
 	BoxTrace(BoxHit);
 	DesiredZ = BoxHit.ImpactPoint.Z + 50.f;
-
+	SetHoverDescent(DesiredZ, DescentSpeed);
 }
 
 void ASoul::BoxTrace(FHitResult& BoxHit)
 {
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashSoulBoxTrace);
+
 	const FVector StartLocation = GetActorLocation();
 	const FVector EndLocation = StartLocation - FVector(0.f, 0.f, 2000.f);
 
@@ -66,5 +71,5 @@ void ASoul::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Ot
 	{
 		PickupInterface->AddSouls(this);
 	}
-	Destroy();
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
@@ -4,6 +4,7 @@
 #include "Items/Treasure.h"
 #include "Kismet/GameplayStatics.h" 
 #include "Characters/SlashCharacter.h"
+#include "Pooling/ActorPoolSubsystem.h"
 
 ATreasure::ATreasure()
 {
@@ -17,5 +18,5 @@ void ATreasure::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor
 		PickupInterface->AddGold(this);
 	}
 	Super::OnSphereOverlap(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
-	Destroy();
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
@@ -3,20 +3,33 @@
 #include "Items/Weapon.h"
 #include "Characters/SlashCharacter.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Components/SphereComponent.h"
 #include "Components/BoxComponent.h"
 #include "Interfaces/HitInterface.h"
+#include "Components/CombatFlagsComponent.h"
 #include "NiagaraComponent.h"
+#include "Slash/SlashDebugDraw.h"
+#include "Slash/SlashStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Weapon BoxTrace"), STAT_SlashWeaponBoxTrace, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Weapon ProcessHit"), STAT_SlashWeaponProcessHit, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Blade Sweeps"), STAT_SlashWeaponSweeps, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Hits"), STAT_SlashWeaponHits, STATGROUP_Slash);
 
 AWeapon::AWeapon()
 {
+	// Only ticks while a swing window is open
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
 	WeaponBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Weapon Box"));
 	WeaponBox->SetupAttachment(GetRootComponent());
 	WeaponBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 	WeaponBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Overlap);
 	WeaponBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
 	WeaponBox->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
+	// The box only marks the active window now; hits come from the per-frame sweep in BoxTrace
+	WeaponBox->SetGenerateOverlapEvents(false);
 
 	Sphere->SetSphereRadius(70.f);
 
@@ -25,21 +38,99 @@ AWeapon::AWeapon()
 
 	BoxTraceStart->SetupAttachment(GetRootComponent());
 	BoxTraceEnd->SetupAttachment(GetRootComponent());
+
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldStatic);
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_WorldDynamic);
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_PhysicsBody);
+	SwingObjectParams.AddObjectTypesToQuery(ECollisionChannel::ECC_Destructible);
+}
+
+void AWeapon::PreInitializeComponents()
+{
+	PrepareForOwnerSpawn();
+	Super::PreInitializeComponents();
 }
 
 void AWeapon::BeginPlay()
 {
 	Super::BeginPlay();
-	WeaponBox->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::OnBoxOverlap);
+}
+
+void AWeapon::OnAcquiredFromPool()
+{
+	PrepareForOwnerSpawn();
+	Super::OnAcquiredFromPool();
+}
+
+void AWeapon::OnReturnedToPool()
+{
+	Super::OnReturnedToPool();
+
+	EndSwing();
+	WeaponBox->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	if (USceneComponent* Parent = ItemMesh->GetAttachParent())
+	{
+		RemoveTickPrerequisiteComponent(Parent);
+		ItemMesh->DetachFromComponent(FDetachmentTransformRules::KeepWorldTransform);
+	}
+	SetInstigator(nullptr);
+}
+
+void AWeapon::PrepareForOwnerSpawn()
+{
+	// A weapon handed out with an owner goes straight into that owner's hand, so its embers never need to start
+	if (GetOwner())
+	{
+		ItemState = EItemState::EIS_Equipped;
+		if (ItemEffect)
+		{
+			ItemEffect->SetAutoActivate(false);
+		}
+	}
+}
+
+void AWeapon::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bSwingActive)
+	{
+		BoxTrace();
+	}
+}
+
+void AWeapon::BeginSwing()
+{
+	bSwingActive = true;
+	bHasPreviousBlade = false;
+	SwingHitActors.Reset();
+	SetActorTickEnabled(true);
+
+	SwingQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(WeaponSwing), false, this);
+	SwingQueryParams.AddIgnoredActor(GetOwner());
+
+	// The trace points are rigid on the weapon, so the blade tip can be rebuilt from any sampled base transform
+	BladeLocalEnd = BoxTraceStart->GetComponentTransform().InverseTransformPosition(BoxTraceEnd->GetComponentLocation());
+}
+
+void AWeapon::EndSwing()
+{
+	bSwingActive = false;
+	bHasPreviousBlade = false;
+	SwingHitActors.Reset();
+	SetActorTickEnabled(false);
 }
 
 void AWeapon::Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator)
 {
 	ItemState = EItemState::EIS_Equipped;
+	StopHovering();
 	SetOwner(NewOwner);
 	SetInstigator(NewInstigator);
 	AttachMeshToSocket(InParent, InSocketName);
 	DisableSphereCollision();
+	// Sweep against the blade pose the parent mesh produced this frame
+	AddTickPrerequisiteComponent(InParent);
 
 	PlayEquipSound();
 	DeactivateEmbers();
@@ -49,7 +140,8 @@ void AWeapon::DeactivateEmbers()
 {
 	if (ItemEffect)
 	{
-		ItemEffect->DestroyComponent();
+		// Deactivated rather than destroyed so a pooled weapon keeps its component
+		ItemEffect->Deactivate();
 	}
 }
 
@@ -75,64 +167,133 @@ void AWeapon::AttachMeshToSocket(USceneComponent* InParent, const FName& InSocke
 	ItemMesh->AttachToComponent(InParent, TransformRules, InSocketName);
 }
 
-void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+bool AWeapon::ActorIsSameType(AActor* OtherActor)
 {
-	if (ActorIsSameType(OtherActor)) return;
-
-	FHitResult BoxHit;
-	BoxTrace(BoxHit);
+	return UCombatFlagsComponent::ActorHasAnyFlags(GetOwner(), ECombatFlags::ECF_Enemy) && UCombatFlagsComponent::ActorHasAnyFlags(OtherActor, ECombatFlags::ECF_Enemy);
+}
 
-	if (BoxHit.GetActor() && !ActorIsSameType(BoxHit.GetActor()))
+void AWeapon::ExecuteGetHit(const FHitResult& BoxHit)
+{
+	IHitInterface* HitInterface = Cast<IHitInterface>(BoxHit.GetActor());
+	if (HitInterface)
 	{
-		UGameplayStatics::ApplyDamage(BoxHit.GetActor(), Damage, GetInstigator()->GetController(), this, UDamageType::StaticClass());
-		ExecuteGetHit(BoxHit);	
-		CreateFields(BoxHit.ImpactPoint);
+		HitInterface->Execute_GetHit(BoxHit.GetActor(), BoxHit.ImpactPoint, GetOwner());
 	}
 }
 
-bool AWeapon::ActorIsSameType(AActor* OtherActor)
+void AWeapon::BoxTrace()
 {
-	return GetOwner()->ActorHasTag(TEXT("Enemy")) && OtherActor->ActorHasTag(TEXT("Enemy"));
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashWeaponBoxTrace);
+
+	UWorld* World = GetWorld();
+	if (World == nullptr) return;
+
+	const FTransform BladeTransform = BoxTraceStart->GetComponentTransform();
+	const FTransform OwnerTransform = GetOwner() ? GetOwner()->GetActorTransform() : FTransform::Identity;
+
+	SweepHits.Reset();
+	if (!bHasPreviousBlade)
+	{
+		SweepBladeSegment(World, BladeTransform, BladeTransform);
+	}
+	else
+	{
+		// At low tick rates the blade covers a long arc between frames. Rebuild intermediate poses in the owner's
+		// space (where the swing is mostly a rotation) and sweep each sub-step, so the arc isn't cut by a straight chord.
+		const double TipTravel = FVector::Dist(PreviousBladeTransform.TransformPosition(BladeLocalEnd), BladeTransform.TransformPosition(BladeLocalEnd));
+		const int32 NumSubsteps = FMath::Clamp(FMath::CeilToInt32(TipTravel / SubstepTipTravel), 1, MaxSweepSubsteps);
+
+		const FTransform PreviousBladeInOwner = PreviousBladeTransform.GetRelativeTransform(PreviousOwnerTransform);
+		const FTransform BladeInOwner = BladeTransform.GetRelativeTransform(OwnerTransform);
+
+		FTransform From = PreviousBladeTransform;
+		for (int32 Substep = 1; Substep <= NumSubsteps; ++Substep)
+		{
+			FTransform To = BladeTransform;
+			if (Substep < NumSubsteps)
+			{
+				const float Alpha = float(Substep) / NumSubsteps;
+				FTransform SampledOwner;
+				SampledOwner.Blend(PreviousOwnerTransform, OwnerTransform, Alpha);
+				FTransform SampledBladeInOwner;
+				SampledBladeInOwner.Blend(PreviousBladeInOwner, BladeInOwner, Alpha);
+				To = SampledBladeInOwner * SampledOwner;
+			}
+
+			SweepBladeSegment(World, From, To);
+			From = To;
+		}
+	}
+
+	PreviousBladeTransform = BladeTransform;
+	PreviousOwnerTransform = OwnerTransform;
+	bHasPreviousBlade = true;
+
+	// Hits from every sub-step are merged in sweep order, so each victim is resolved once at its earliest contact
+	for (const FHitResult& Hit : SweepHits)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (SwingHitActors.Contains(HitActor)) continue;
+
+		SwingHitActors.Add(HitActor);
+		SwingQueryParams.AddIgnoredActor(HitActor);
+
+		if (!ActorIsSameType(HitActor))
+		{
+			ProcessHit(Hit);
+		}
+	}
 }
 
-void AWeapon::ExecuteGetHit(FHitResult& BoxHit)
+void AWeapon::SweepBladeSegment(UWorld* World, const FTransform& From, const FTransform& To)
 {
-	IHitInterface* HitInterface = Cast<IHitInterface>(BoxHit.GetActor());
-	if (HitInterface)
+	// Sweep a box covering the whole blade from one sampled pose to the next
+	const FVector Start = To.GetLocation();
+	const FVector End = To.TransformPosition(BladeLocalEnd);
+	const FVector BladeAxis = End - Start;
+	const double BladeLength = BladeAxis.Size();
+	const FQuat BladeRotation = BladeLength > UE_KINDA_SMALL_NUMBER ? FRotationMatrix::MakeFromX(BladeAxis).ToQuat() : To.GetRotation();
+	const FVector BladeHalfExtent(BladeLength * 0.5 + BoxTraceExtent.X, BoxTraceExtent.Y, BoxTraceExtent.Z);
+	const FVector BladeCenter = (Start + End) * 0.5;
+	const FVector PreviousBladeCenter = (From.GetLocation() + From.TransformPosition(BladeLocalEnd)) * 0.5;
+
+	INC_DWORD_STAT(STAT_SlashWeaponSweeps);
+	SegmentHits.Reset();
+	World->SweepMultiByObjectType(SegmentHits, PreviousBladeCenter, BladeCenter, BladeRotation, SwingObjectParams, FCollisionShape::MakeBox(BladeHalfExtent), SwingQueryParams);
+
+	SLASH_DRAW_BOX(World, Weapon, BladeCenter, BladeHalfExtent, BladeRotation, SegmentHits.Num() > 0 ? FColor::Green : FColor::Red, 5.f);
+
+	for (const FHitResult& Hit : SegmentHits)
 	{
-		HitInterface->Execute_GetHit(BoxHit.GetActor(), BoxHit.ImpactPoint, GetOwner());
+		AActor* HitActor = Hit.GetActor();
+		if (HitActor == nullptr) continue;
+
+		// Object queries ignore collision responses, so they also report pickups, other weapons' boxes and
+		// trigger volumes; only hit-interface actors take a hit, and level geometry still shields whatever is behind it
+		if (!HitActor->Implements<UHitInterface>())
+		{
+			if (Hit.GetComponent() && Hit.GetComponent()->GetCollisionObjectType() == ECollisionChannel::ECC_WorldStatic) break;
+			continue;
+		}
+
+		SweepHits.Add(Hit);
 	}
 }
 
-void AWeapon::BoxTrace(FHitResult& BoxHit)
+void AWeapon::ProcessHit(const FHitResult& BoxHit)
 {
-	const FVector Start = BoxTraceStart->GetComponentLocation();
-	const FVector End = BoxTraceEnd->GetComponentLocation();
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashWeaponProcessHit);
+	INC_DWORD_STAT(STAT_SlashWeaponHits);
 
-	TArray<AActor*> ActorsToIgnore;
-	ActorsToIgnore.Add(this);
-	ActorsToIgnore.Add(GetOwner());
-
-	for (AActor* Actor : IgnoreActors)
+	FHitResult Hit = BoxHit;
+	if (Hit.bStartPenetrating && Hit.GetComponent())
 	{
-		ActorsToIgnore.AddUnique(Actor);
+		// Overlaps at sweep start carry no impact point; use the closest point on the victim to the blade
+		FVector ClosestPoint;
+		Hit.ImpactPoint = Hit.GetComponent()->GetClosestPointOnCollision(Hit.TraceEnd, ClosestPoint) >= 0.f ? ClosestPoint : FVector(Hit.TraceEnd);
 	}
 
-	UKismetSystemLibrary::BoxTraceSingle(
-		this,
-		Start,
-		End,
-		BoxTraceExtent,
-		BoxTraceStart->GetComponentRotation(),
-		ETraceTypeQuery::TraceTypeQuery1,
-		false,
-		ActorsToIgnore,
-		bShowBoxDebug ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
-		BoxHit,
-		true,
-		FLinearColor::Red,
-		FLinearColor::Green,
-		5.0f);
-
-	IgnoreActors.AddUnique(BoxHit.GetActor());
-}
\ No newline at end of file
+	UGameplayStatics::ApplyDamage(Hit.GetActor(), Damage, GetInstigator()->GetController(), this, UDamageType::StaticClass());
+	ExecuteGetHit(Hit);
+	CreateFields(Hit.ImpactPoint);
+}
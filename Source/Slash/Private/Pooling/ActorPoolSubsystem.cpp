@@ -0,0 +1,190 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Pooling/ActorPoolSubsystem.h"
+#include "Interfaces/PoolableInterface.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<int32> CVarActorPoolPrewarmCount(
+	TEXT("Slash.Pool.PrewarmCount"),
+	4,
+	TEXT("Default number of dormant instances spawned per pooled actor class."),
+	ECVF_Default);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actor Pool Hits"), STAT_SlashActorPoolHits, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actor Pool Misses"), STAT_SlashActorPoolMisses, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Actor Pool Free Instances"), STAT_SlashActorPoolFree, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Actors Spawned"), STAT_SlashPooledActorsSpawned, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Actors Destroyed Without Pool"), STAT_SlashActorsDestroyed, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Actor Pool Acquire"), STAT_SlashActorPoolAcquire, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Actor Pool Release"), STAT_SlashActorPoolRelease, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Actor Pool Spawn"), STAT_SlashActorPoolSpawn, STATGROUP_Slash);
+
+void UActorPoolSubsystem::Deinitialize()
+{
+	// The world tears the actors down itself; only the bookkeeping goes here
+	for (const TPair<UClass*, FActorPoolBucket>& Bucket : Buckets)
+	{
+		DEC_DWORD_STAT_BY(STAT_SlashActorPoolFree, Bucket.Value.FreeActors.Num());
+	}
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UActorPoolSubsystem::Prewarm(UClass* Class, int32 Count)
+{
+	if (Class == nullptr) return;
+
+	// Spawning runs BeginPlay, which may prewarm other classes, so the bucket is looked up again each time
+	while (Buckets.FindOrAdd(Class).NumSpawned < Count)
+	{
+		AActor* Actor = SpawnPooledActor(Class, FTransform::Identity, nullptr, true);
+		if (Actor == nullptr) break;
+
+		if (IPoolableInterface* Poolable = Cast<IPoolableInterface>(Actor))
+		{
+			Poolable->OnReturnedToPool();
+		}
+		Deactivate(Actor);
+		Buckets.FindChecked(Class).FreeActors.Add(Actor);
+		INC_DWORD_STAT(STAT_SlashActorPoolFree);
+	}
+}
+
+void UActorPoolSubsystem::Prewarm(UClass* Class)
+{
+	Prewarm(Class, CVarActorPoolPrewarmCount.GetValueOnGameThread());
+}
+
+AActor* UActorPoolSubsystem::AcquireActor(UClass* Class, const FTransform& Transform, AActor* Owner)
+{
+	SLASH_SCOPE_TIMER("ActorPool");
+	SCOPE_CYCLE_COUNTER(STAT_SlashActorPoolAcquire);
+	if (Class == nullptr) return nullptr;
+
+	FActorPoolBucket& Bucket = Buckets.FindOrAdd(Class);
+	while (Bucket.FreeActors.Num() > 0)
+	{
+		AActor* Actor = Bucket.FreeActors.Pop(false);
+		DEC_DWORD_STAT(STAT_SlashActorPoolFree);
+
+		// Pooled actors can still be destroyed from outside (level streaming, Blueprint logic)
+		if (!IsValid(Actor))
+		{
+			--Bucket.NumSpawned;
+			continue;
+		}
+
+		++Bucket.Hits;
+		INC_DWORD_STAT(STAT_SlashActorPoolHits);
+
+		// Move while still hidden and collision-less so nothing overlaps at the old spot
+		Actor->SetOwner(Owner);
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+
+		if (IPoolableInterface* Poolable = Cast<IPoolableInterface>(Actor))
+		{
+			Poolable->OnAcquiredFromPool();
+		}
+		return Actor;
+	}
+
+	++Bucket.Misses;
+	INC_DWORD_STAT(STAT_SlashActorPoolMisses);
+	return SpawnPooledActor(Class, Transform, Owner, false);
+}
+
+void UActorPoolSubsystem::Release(AActor* Actor)
+{
+	SLASH_SCOPE_TIMER("ActorPool");
+	SCOPE_CYCLE_COUNTER(STAT_SlashActorPoolRelease);
+	if (!IsValid(Actor)) return;
+
+	const FActorPoolBucket* Existing = Buckets.Find(Actor->GetClass());
+	if (Existing && Existing->FreeActors.Contains(Actor)) return;
+
+	if (IPoolableInterface* Poolable = Cast<IPoolableInterface>(Actor))
+	{
+		Poolable->OnReturnedToPool();
+	}
+	Deactivate(Actor);
+
+	Buckets.FindOrAdd(Actor->GetClass()).FreeActors.Add(Actor);
+	INC_DWORD_STAT(STAT_SlashActorPoolFree);
+}
+
+void UActorPoolSubsystem::ReleaseOrDestroy(AActor* Actor)
+{
+	if (Actor == nullptr) return;
+
+	UWorld* World = Actor->GetWorld();
+	if (UActorPoolSubsystem* Pool = World ? World->GetSubsystem<UActorPoolSubsystem>() : nullptr)
+	{
+		Pool->Release(Actor);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_SlashActorsDestroyed);
+		Actor->Destroy();
+	}
+}
+
+AActor* UActorPoolSubsystem::SpawnPooledActor(UClass* Class, const FTransform& Transform, AActor* Owner, bool bDormant)
+{
+	SLASH_SCOPE_CYCLE_COUNTER(STAT_SlashActorPoolSpawn);
+
+	UWorld* World = GetWorld();
+	if (World == nullptr) return nullptr;
+
+	INC_DWORD_STAT(STAT_SlashPooledActorsSpawned);
+	AActor* Actor = World->SpawnActorDeferred<AActor>(Class, Transform, Owner, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Actor == nullptr) return nullptr;
+
+	if (bDormant)
+	{
+		// Keep prewarmed instances from ever registering overlaps at the spawn point
+		Actor->SetActorHiddenInGame(true);
+		Actor->SetActorEnableCollision(false);
+	}
+	Actor->FinishSpawning(Transform);
+
+	++Buckets.FindOrAdd(Class).NumSpawned;
+	return Actor;
+}
+
+void UActorPoolSubsystem::Deactivate(AActor* Actor)
+{
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	Actor->SetOwner(nullptr);
+}
+
+void UActorPoolSubsystem::DumpStats() const
+{
+	for (const TPair<UClass*, FActorPoolBucket>& Bucket : Buckets)
+	{
+		const FActorPoolBucket& Pool = Bucket.Value;
+		const int32 Requests = Pool.Hits + Pool.Misses;
+		UE_LOG(LogSlash, Display, TEXT("%s: %d spawned, %d free, %d hits, %d misses (%.1f%% hit rate)"),
+			*GetNameSafe(Bucket.Key), Pool.NumSpawned, Pool.FreeActors.Num(), Pool.Hits, Pool.Misses,
+			Requests > 0 ? 100.f * Pool.Hits / Requests : 0.f);
+	}
+}
+
+static FAutoConsoleCommandWithWorld DumpActorPoolsCommand(
+	TEXT("Slash.Pool.Dump"),
+	TEXT("Logs per-class actor pool sizes and hit/miss counts."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const UActorPoolSubsystem* Pool = World ? World->GetSubsystem<UActorPoolSubsystem>() : nullptr)
+		{
+			Pool->DumpStats();
+		}
+	}));
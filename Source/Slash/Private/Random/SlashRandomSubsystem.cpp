@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Random/SlashRandomSubsystem.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Slash/Slash.h"
+
+static TAutoConsoleVariable<int32> CVarSlashRandomSeed(
+	TEXT("Slash.Random.Seed"),
+	0,
+	TEXT("Seed for gameplay random streams in newly created worlds. 0 seeds from the clock."),
+	ECVF_Default);
+
+void USlashRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	int32 Seed = CVarSlashRandomSeed.GetValueOnGameThread();
+	FParse::Value(FCommandLine::Get(), TEXT("SlashSeed="), Seed);
+	Reseed(Seed != 0 ? static_cast<uint64>(Seed) : FPlatformTime::Cycles64());
+}
+
+void USlashRandomSubsystem::Reseed(uint64 InWorldSeed)
+{
+	WorldSeed = InWorldSeed;
+
+	// Streams start from distinct seeds rather than jumps of one generator, so adding a stream doesn't move the others
+	for (int32 Index = 0; Index < UE_ARRAY_COUNT(Streams); ++Index)
+	{
+		Streams[Index].Seed(WorldSeed ^ (0x9e3779b97f4a7c15ull * (Index + 1)));
+	}
+	UE_LOG(LogSlash, Log, TEXT("%s random seed %llu"), *GetWorld()->GetName(), WorldSeed);
+}
+
+FSlashRng& USlashRandomSubsystem::GetStream(ESlashRandomStream Stream)
+{
+	check(IsInGameThread());
+	return Streams[static_cast<int32>(Stream)];
+}
+
+void USlashRandomSubsystem::ForkStream(ESlashRandomStream Stream, int32 NumForks, TArray<FSlashRng>& OutForks)
+{
+	FSlashRng& Parent = GetStream(Stream);
+	OutForks.Reserve(OutForks.Num() + NumForks);
+	for (int32 Fork = 0; Fork < NumForks; ++Fork)
+	{
+		OutForks.Add(Parent.Fork());
+	}
+}
+
+FSlashRng& USlashRandomSubsystem::Get(const UObject* WorldContext, ESlashRandomStream Stream)
+{
+	const UWorld* World = WorldContext ? WorldContext->GetWorld() : nullptr;
+	if (USlashRandomSubsystem* Random = World ? World->GetSubsystem<USlashRandomSubsystem>() : nullptr)
+	{
+		return Random->GetStream(Stream);
+	}
+
+	check(IsInGameThread());
+	static FSlashRng Fallback(FPlatformTime::Cycles64());
+	return Fallback;
+}
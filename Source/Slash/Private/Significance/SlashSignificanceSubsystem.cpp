@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Significance/SlashSignificanceSubsystem.h"
+#include "Enemy/Enemy.h"
+#include "Items/Item.h"
+#include "GroomComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashStats.h"
+
+static TAutoConsoleVariable<float> CVarSignificanceInterval(
+	TEXT("Slash.Significance.Interval"),
+	0.25f,
+	TEXT("Seconds between significance evaluations."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceHighDistance(
+	TEXT("Slash.Significance.HighDistance"),
+	1500.f,
+	TEXT("Visible objects closer than this to a player view stay at full detail."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceMediumDistance(
+	TEXT("Slash.Significance.MediumDistance"),
+	4000.f,
+	TEXT("Visible objects closer than this to a player view run at medium detail."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceCullDistance(
+	TEXT("Slash.Significance.CullDistance"),
+	10000.f,
+	TEXT("Objects farther than this from every player view are culled; anything nearer but unseen runs at low detail."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarSignificanceRenderTimeout(
+	TEXT("Slash.Significance.RenderTimeout"),
+	0.5f,
+	TEXT("Seconds since an object was last rendered before it counts as unseen."),
+	ECVF_Default);
+
+void USlashSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	SLASH_SCOPE_TIMER("Significance");
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (Now < NextEvaluationTime) return;
+	NextEvaluationTime = Now + CVarSignificanceInterval.GetValueOnGameThread();
+
+	Evaluate();
+}
+
+TStatId USlashSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void USlashSignificanceSubsystem::Deinitialize()
+{
+	Components.Empty();
+	Categories.Empty();
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+void USlashSignificanceSubsystem::Register(UPrimitiveComponent* Component, ESignificanceCategory Category)
+{
+	if (Component == nullptr || Components.Contains(Component)) return;
+
+	// Everything starts at full detail, which is what it was authored for
+	Components.Add(Component);
+	Categories.Add(Category);
+	Buckets.Add(ESignificanceBucket::High);
+}
+
+void USlashSignificanceSubsystem::Unregister(UPrimitiveComponent* Component)
+{
+	const int32 Index = Components.Find(Component);
+	if (Index == INDEX_NONE) return;
+
+	Components.RemoveAtSwap(Index, 1, false);
+	Categories.RemoveAtSwap(Index, 1, false);
+	Buckets.RemoveAtSwap(Index, 1, false);
+}
+
+void USlashSignificanceSubsystem::Evaluate()
+{
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
+	if (ViewLocations.Num() == 0) return;
+
+	for (int32 Index = Components.Num() - 1; Index >= 0; --Index)
+	{
+		UPrimitiveComponent* Component = Components[Index];
+		if (Component == nullptr)
+		{
+			Components.RemoveAtSwap(Index, 1, false);
+			Categories.RemoveAtSwap(Index, 1, false);
+			Buckets.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		const ESignificanceBucket Bucket = ScoreBucket(Component, ViewLocations);
+		if (Bucket != Buckets[Index])
+		{
+			Buckets[Index] = Bucket;
+			ApplyBucket(Component, Categories[Index], Bucket);
+		}
+	}
+}
+
+ESignificanceBucket USlashSignificanceSubsystem::ScoreBucket(const UPrimitiveComponent* Component, const TArray<FVector, TInlineAllocator<4>>& ViewLocations) const
+{
+	const FVector Location = Component->GetComponentLocation();
+	double MinDistanceSquared = TNumericLimits<double>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Location, ViewLocation));
+	}
+
+	const float CullDistance = CVarSignificanceCullDistance.GetValueOnGameThread();
+	if (MinDistanceSquared > FMath::Square(CullDistance)) return ESignificanceBucket::Culled;
+
+	// Unseen but nearby: keep it alive at the lowest rate so it's current when it comes into view
+	if (!Component->WasRecentlyRendered(CVarSignificanceRenderTimeout.GetValueOnGameThread())) return ESignificanceBucket::Low;
+
+	if (MinDistanceSquared < FMath::Square(CVarSignificanceHighDistance.GetValueOnGameThread())) return ESignificanceBucket::High;
+	if (MinDistanceSquared < FMath::Square(CVarSignificanceMediumDistance.GetValueOnGameThread())) return ESignificanceBucket::Medium;
+	return ESignificanceBucket::Low;
+}
+
+void USlashSignificanceSubsystem::ApplyBucket(UPrimitiveComponent* Component, ESignificanceCategory Category, ESignificanceBucket Bucket)
+{
+	switch (Category)
+	{
+	case ESignificanceCategory::Enemy:
+		if (AEnemy* Enemy = Cast<AEnemy>(Component->GetOwner()))
+		{
+			Enemy->SetSignificance(Bucket);
+		}
+		break;
+
+	case ESignificanceCategory::Item:
+		if (AItem* Item = Cast<AItem>(Component->GetOwner()))
+		{
+			Item->SetSignificance(Bucket);
+		}
+		break;
+
+	case ESignificanceCategory::Groom:
+		if (UGroomComponent* Groom = Cast<UGroomComponent>(Component))
+		{
+			// Strands are the most expensive thing on the player; drop to the coarsest LOD once they're small on screen
+			static constexpr float GroomTickIntervals[] = { 0.f, 1.f / 30.f, 0.1f, 0.25f };
+			const int32 LastLOD = FMath::Max(Groom->GetNumLODs() - 1, 0);
+			const int32 ForcedLOD = Bucket == ESignificanceBucket::High ? INDEX_NONE : FMath::Min(static_cast<int32>(Bucket), LastLOD);
+			Groom->SetForcedLOD(ForcedLOD);
+			Groom->SetComponentTickInterval(GroomTickIntervals[static_cast<int32>(Bucket)]);
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void USlashSignificanceSubsystem::DumpBuckets() const
+{
+	static const TCHAR* CategoryNames[] = { TEXT("Enemy"), TEXT("Item"), TEXT("Groom") };
+	static_assert(UE_ARRAY_COUNT(CategoryNames) == static_cast<int32>(ESignificanceCategory::Num), "Missing significance category name");
+
+	int32 Counts[static_cast<int32>(ESignificanceCategory::Num)][static_cast<int32>(ESignificanceBucket::Num)] = {};
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		++Counts[static_cast<int32>(Categories[Index])][static_cast<int32>(Buckets[Index])];
+	}
+
+	UE_LOG(LogSlash, Display, TEXT("Significance: %d registered"), Components.Num());
+	for (int32 Category = 0; Category < static_cast<int32>(ESignificanceCategory::Num); ++Category)
+	{
+		UE_LOG(LogSlash, Display, TEXT("  %-6s High %4d  Medium %4d  Low %4d  Culled %4d"), CategoryNames[Category],
+			Counts[Category][0], Counts[Category][1], Counts[Category][2], Counts[Category][3]);
+	}
+}
+
+static FAutoConsoleCommandWithWorld DumpSignificanceCommand(
+	TEXT("Slash.Significance.Dump"),
+	TEXT("Logs how many enemies, items and grooms are in each significance bucket."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		if (const USlashSignificanceSubsystem* Significance = World ? World->GetSubsystem<USlashSignificanceSubsystem>() : nullptr)
+		{
+			Significance->DumpBuckets();
+		}
+	}));
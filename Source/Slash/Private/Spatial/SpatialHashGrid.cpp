@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Spatial/SpatialHashGrid.h"
+
+FSpatialHashGrid::FSpatialHashGrid(float InCellSize)
+{
+	SetCellSize(InCellSize);
+}
+
+void FSpatialHashGrid::SetCellSize(float InCellSize)
+{
+	CellSize = FMath::Max(InCellSize, 1.f);
+	InvCellSize = 1.f / CellSize;
+}
+
+void FSpatialHashGrid::Build(TConstArrayView<FVector> InPoints)
+{
+	Points.Reset(InPoints.Num());
+	Points.Append(InPoints.GetData(), InPoints.Num());
+
+	PointKeys.Reset(Points.Num());
+	SortedIndices.Reset(Points.Num());
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		PointKeys.Add(CellKey(ToCell(Points[Index].X), ToCell(Points[Index].Y)));
+		SortedIndices.Add(Index);
+	}
+	SortedIndices.Sort([this](int32 A, int32 B) { return PointKeys[A] < PointKeys[B]; });
+
+	CellRanges.Reset();
+	for (int32 Slot = 0; Slot < SortedIndices.Num();)
+	{
+		const uint64 Key = PointKeys[SortedIndices[Slot]];
+		const int32 Start = Slot;
+		while (Slot < SortedIndices.Num() && PointKeys[SortedIndices[Slot]] == Key)
+		{
+			++Slot;
+		}
+		CellRanges.Add(Key, TPair<int32, int32>(Start, Slot - Start));
+	}
+}
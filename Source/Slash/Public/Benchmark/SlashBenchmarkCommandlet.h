@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SlashBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless combat simulation for tracking how the game scales across commits.
+ * Loads -Map= as a game world, which must have a floor and a built navmesh covering +-Extent
+ * around the origin. Spawns patrolling enemies on the navmesh, a scripted player stand-in
+ * and scattered props, ticks a fixed number of frames at a fixed timestep and writes
+ * frame-time percentiles, per-subsystem game-thread time, spawn/destroy counts and peak
+ * memory to JSON and CSV. A run fails if fewer than half of the enemies still patrolling at
+ * the end have walked away from where they spawned.
+ *
+ * UnrealEditor-Cmd Slash.uproject -run=SlashBenchmark -nullrhi -unattended
+ *     -Map=/Game/Maps/Bench [-Enemies=100] [-Props=50] [-Frames=1800] [-WarmupFrames=60]
+ *     [-DeltaTime=0.016667] [-Seed=1] [-Extent=8000] [-Output=Saved/Benchmark/Slash.json]
+ *     [-PatrolOnly] [-Movement=Full|Lightweight|Compare]
+ *     [-EnemyClass=/Game/...BP_Enemy_C] [-PlayerClass=...] [-BreakableClass=...] [-TreasureClass=...]
+ *
+ * -PatrolOnly leaves out the player stand-in so every enemy patrols for the whole run.
+ * -Movement pins Slash.AI.LightweightMovement; Compare runs the scenario once per mode and
+ * writes <Output>-Full.json and <Output>-Lightweight.json, e.g. for 1000 patrolling enemies:
+ *     -run=SlashBenchmark -Map=/Game/Maps/Bench -Enemies=1000 -Props=0 -PatrolOnly -Movement=Compare
+ */
+UCLASS()
+class SLASH_API USlashBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USlashBenchmarkCommandlet();
+
+	/** UCommandlet */
+	virtual int32 Main(const FString& Params) override;
+};
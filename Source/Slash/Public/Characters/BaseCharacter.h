@@ -14,7 +14,7 @@ class SLASH_API ABaseCharacter : public ACharacter, public IHitInterface
 	GENERATED_BODY()
 
 public:
-	ABaseCharacter();
+	ABaseCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual void Tick(float DeltaTime) override;
 
 protected:
@@ -24,6 +24,9 @@ protected:
 	UPROPERTY(VisibleAnywhere)
 		class UAttributeComponent* Attributes;
 
+	UPROPERTY(VisibleAnywhere)
+		class UCombatFlagsComponent* CombatFlags;
+
 	UPROPERTY(VisibleAnywhere, Category = Weapon)
 		class AWeapon* EquippedWeapon;
 
@@ -103,4 +106,5 @@ private:
 
 public:
 	FORCEINLINE TEnumAsByte<EDeathPose> GetDeathPose() const { return DeathPose; }
+	FORCEINLINE UCombatFlagsComponent* GetCombatFlags() const { return CombatFlags; }
 };
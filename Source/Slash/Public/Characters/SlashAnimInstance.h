@@ -7,10 +7,28 @@
 #include "CharacterTypes.h"
 #include "SlashAnimInstance.generated.h"
 
+class ABaseCharacter;
 class ASlashCharacter;
+class AEnemy;
 class UCharacterMovementComponent;
+
+/** Game-thread copy of everything the anim graph needs from its character. */
+struct FSlashAnimSnapshot
+{
+	FVector Velocity = FVector::ZeroVector;
+	bool bIsFalling = false;
+	ECharacterState CharacterState = ECharacterState::ECS_Unequipped;
+	EActionState ActionState = EActionState::EAS_Unoccupied;
+	EEnemyState EnemyState = EEnemyState::EES_Patrolling;
+	TEnumAsByte<EDeathPose> DeathPose = EDeathPose::EDP_MAX;
+};
+
 /**
- * 
+ * Anim instance shared by the player and enemies. The game thread only copies a handful of
+ * values into FSlashAnimSnapshot; everything derived from them is computed in
+ * NativeThreadSafeUpdateAnimation, so with multithreaded animation update enabled on the anim
+ * Blueprint the graph runs on worker threads. Blueprint graphs should read the exposed
+ * properties (or use BlueprintThreadSafeUpdateAnimation), not the character.
  */
 UCLASS()
 class SLASH_API USlashAnimInstance : public UAnimInstance
@@ -20,6 +38,7 @@ class SLASH_API USlashAnimInstance : public UAnimInstance
 public:
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaTime) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaTime) override;
 
 	UPROPERTY(BlueprintReadOnly);
 	ASlashCharacter* SlashCharacter;
@@ -42,4 +61,15 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = Movement);
 	TEnumAsByte<EDeathPose> DeathPose;
 
+	UPROPERTY(BlueprintReadOnly, Category = Movement);
+	EEnemyState EnemyState;
+
+private:
+	UPROPERTY(Transient)
+	ABaseCharacter* Character;
+
+	UPROPERTY(Transient)
+	AEnemy* Enemy;
+
+	FSlashAnimSnapshot Snapshot;
 };
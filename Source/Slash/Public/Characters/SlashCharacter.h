@@ -16,7 +16,6 @@ class SLASH_API ASlashCharacter : public ABaseCharacter, public IPickupInterface
 
 public:
 	ASlashCharacter();
-	virtual void Tick(float DeltaTime) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 	virtual void Jump() override;
 
@@ -35,6 +34,7 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere)
 		class UTargetSystemComponent* TargetSystem;
@@ -138,7 +138,6 @@ private:
 	bool IsUnoccupied();
 	
 	void InitializeOverlay();
-	void SetHUDHealth();
 	
 
 public:
@@ -6,6 +6,8 @@
 #include "Components/ActorComponent.h"
 #include "AttributeComponent.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnAttributeChanged, float /*NewValue*/, float /*MaxValue*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnCountChanged, int32 /*NewValue*/);
 
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class SLASH_API UAttributeComponent : public UActorComponent
@@ -15,7 +17,12 @@ class SLASH_API UAttributeComponent : public UActorComponent
 public:	
 	UAttributeComponent();
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-	void RegenStamina(float DeltaTime);
+
+	/** Native change notifications. Stamina fires when spent and once more when regen completes, not while it fills. */
+	FOnAttributeChanged OnHealthChanged;
+	FOnAttributeChanged OnStaminaChanged;
+	FOnCountChanged OnGoldChanged;
+	FOnCountChanged OnSoulsChanged;
 	
 protected:
 	virtual void BeginPlay() override;
@@ -28,6 +35,7 @@ private:
 	UPROPERTY(Editanywhere, Category = "Actor Attributes")
 	float MaxHealth;
 
+	/** Stamina at StaminaTimestamp; the current value is extrapolated from it on read. */
 	UPROPERTY(Editanywhere, Category = "Actor Attributes")
 	float Stamina;
 
@@ -49,11 +57,20 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Actor Attributes")
 	float StaminaRegenRate = 8.f;
 
+	double StaminaTimestamp = 0.0;
+	FTimerHandle StaminaRegenTimer;
+
+	double GetWorldTimeSeconds() const;
+	void RebaseStamina(float NewStamina);
+	void OnStaminaRegenComplete();
+
 public:
 	void ReceiveDamage(float Damage);
 	void UseStamina(float StaminaCost);
 	float GetHealthPercent();
-	float GetStaminaPercent();
+	float GetStaminaPercent() const;
+	float GetStamina() const;
+	bool IsRegeneratingStamina() const;
 	bool IsAlive();
 	bool HasSufficientStamina(float StaminaCost);
 	void AddSouls(int32 NumberOfSouls);
@@ -61,5 +78,4 @@ public:
 	FORCEINLINE int32 GetGold() const { return Gold; }
 	FORCEINLINE int32 GetSouls() const { return Souls; }
 	FORCEINLINE float GetDodgeCost() const { return DodgeCost; }
-	FORCEINLINE float GetStamina() const { return Stamina; }
 };
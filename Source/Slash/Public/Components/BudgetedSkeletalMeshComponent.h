@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "BudgetedSkeletalMeshComponent.generated.h"
+
+/**
+ * Enemy mesh that runs under the Animation Budget Allocator. Significance is supplied by the
+ * owner instead of being auto-calculated. The component also reports what each full evaluation
+ * costs on the game thread to its world's UEnemyAIDirector, which averages it to estimate the
+ * time saved by skipped frames.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class SLASH_API UBudgetedSkeletalMeshComponent : public USkeletalMeshComponentBudgeted
+{
+	GENERATED_BODY()
+
+public:
+	UBudgetedSkeletalMeshComponent(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+	virtual void OnRegister() override;
+
+private:
+	UPROPERTY()
+	class UEnemyAIDirector* AIDirector;
+};
@@ -0,0 +1,71 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "CombatFlagsComponent.generated.h"
+
+UENUM(BlueprintType, meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class ECombatFlags : uint8
+{
+	ECF_None = 0 UMETA(Hidden),
+	ECF_Enemy = 1 << 0 UMETA(DisplayName = "Enemy"),
+	ECF_Dead = 1 << 1 UMETA(DisplayName = "Dead"),
+	ECF_EngageableTarget = 1 << 2 UMETA(DisplayName = "EngageableTarget")
+};
+ENUM_CLASS_FLAGS(ECombatFlags)
+
+/** Actor tag names mirrored by ECombatFlags, built once instead of per call. */
+namespace SlashTags
+{
+	extern SLASH_API const FName Enemy;
+	extern SLASH_API const FName Dead;
+	extern SLASH_API const FName EngageableTarget;
+}
+
+/**
+ * Faction and combat state as a bitmask so hot paths can test it with a single AND
+ * instead of hashing an FName and scanning AActor::Tags. The flags are the single source
+ * of truth: the owner's Tags are a write-only mirror for Blueprints that still read them
+ * with ActorHasTag, and are only read back once at BeginPlay. Tags added or removed after
+ * that are not seen by C++; change combat state through AddCombatFlags/RemoveCombatFlags.
+ */
+UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
+class SLASH_API UCombatFlagsComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCombatFlagsComponent();
+
+	void AddFlags(ECombatFlags InFlags);
+	void RemoveFlags(ECombatFlags InFlags);
+
+	/** Blueprint entry points; use these rather than editing the owner's Tags directly. */
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void AddCombatFlags(UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/Slash.ECombatFlags")) int32 InFlags);
+
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+	void RemoveCombatFlags(UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/Slash.ECombatFlags")) int32 InFlags);
+
+	UFUNCTION(BlueprintPure, Category = "Combat")
+	bool HasAnyCombatFlags(UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/Slash.ECombatFlags")) int32 InFlags) const;
+
+	/** O(1) for characters, whose flags are authoritative; falls back to AActor::Tags for anything else so Blueprint-tagged actors still match. */
+	static bool ActorHasAnyFlags(const AActor* Actor, ECombatFlags InFlags);
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "Combat", meta = (Bitmask, BitmaskEnum = "/Script/Slash.ECombatFlags"))
+	uint8 Flags = 0;
+
+	void SyncOwnerTags(ECombatFlags Changed, bool bAdded);
+
+public:
+	FORCEINLINE ECombatFlags GetFlags() const { return static_cast<ECombatFlags>(Flags); }
+	FORCEINLINE bool HasAnyFlags(ECombatFlags InFlags) const { return (Flags & static_cast<uint8>(InFlags)) != 0; }
+	FORCEINLINE bool HasAllFlags(ECombatFlags InFlags) const { return (Flags & static_cast<uint8>(InFlags)) == static_cast<uint8>(InFlags); }
+};
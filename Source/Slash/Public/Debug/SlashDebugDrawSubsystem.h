@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Components/LineBatchComponent.h"
+#include "SlashDebugDrawSubsystem.generated.h"
+
+/** Debug draw categories, each behind its own Slash.Debug.* console variable. */
+enum class ESlashDebugDraw : uint8
+{
+	Weapon,
+	AIRanges,
+	Perception,
+	HitReact,
+
+	Num
+};
+
+/**
+ * Collects debug shapes as lines for the frame and hands them to the world's line batcher in
+ * one call after actors have ticked, capped at Slash.Debug.MaxLines. Lines with a duration are
+ * kept here and resubmitted each frame instead of living in the persistent line batcher.
+ * Use the SLASH_DRAW_* macros in SlashDebugDraw.h, which compile out of Shipping and Test.
+ */
+UCLASS()
+class SLASH_API USlashDebugDrawSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	static bool IsEnabled(ESlashDebugDraw Category);
+
+	/** The subsystem for WorldContext's world if Category is enabled, otherwise null. */
+	static USlashDebugDrawSubsystem* Get(const UObject* WorldContext, ESlashDebugDraw Category);
+
+	void AddLine(const FVector& Start, const FVector& End, const FColor& Color, float Duration = 0.f);
+	void AddArrow(const FVector& Start, const FVector& End, const FColor& Color, float Duration = 0.f);
+	void AddBox(const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color, float Duration = 0.f);
+	void AddCircle(const FVector& Center, float Radius, const FColor& Color, float Duration = 0.f);
+	void AddSphere(const FVector& Center, float Radius, const FColor& Color, float Duration = 0.f);
+	void AddPoint(const FVector& Location, const FColor& Color, float Duration = 0.f);
+
+private:
+	void Flush(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	/** RemainingLifeTime is this buffer's own countdown; submitted copies always live a single frame. */
+	TArray<FBatchedLine> Lines;
+	TArray<FBatchedLine> FrameLines;
+	int32 NumDropped = 0;
+
+	FDelegateHandle PostActorTickHandle;
+};
@@ -5,15 +5,20 @@
 #include "Characters/BaseCharacter.h"
 #include "CoreMinimal.h"
 #include "Characters/CharacterTypes.h"
+#include "Enemy/EnemyRangeKernel.h"
+#include "Enemy/EnemyStateTable.h"
+#include "AI/Navigation/NavigationTypes.h"
 #include "Enemy.generated.h"
 
+enum class ESignificanceBucket : uint8;
+
 UCLASS()
 class SLASH_API AEnemy : public ABaseCharacter
 {
 	GENERATED_BODY()
 
 public:
-	AEnemy();
+	AEnemy(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
 	UPROPERTY(EditAnywhere, Category = Combat)
 		float AttackMin = 0.5f;
@@ -22,7 +27,6 @@ public:
 		float AttackMax = 1.f;
 
 	/** AActor */
-	virtual void Tick(float DeltaTime) override;
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void Destroyed() override;
 
@@ -30,6 +34,8 @@ public:
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 
 	/** AI Behaviour */
+	void UpdateAI(EEnemyRangeFlags RangeFlags); // Driven by UEnemyAIDirector instead of a per-actor Tick
+	void AddRangeQuery(FEnemyRangeBatch& Batch) const;
 	void HideHealthBar();
 	void ShowHealthBar();
 	bool IsOutsideCombatRadius();
@@ -43,6 +49,25 @@ public:
 	bool IsAttacking();
 	bool IsChasing();
 	bool IsEngaged();
+	bool IsReceptiveToSight() const;
+
+	UFUNCTION()
+		void PawnSeen(APawn* SeenPawn); // Called by UEnemyPerceptionSubsystem for every visible pawn
+
+	/** Assigns patrol points to a spawned enemy; call before FinishSpawning so BeginPlay starts the patrol. */
+	void SetPatrolTargets(const TArray<AActor*>& InPatrolTargets);
+
+	/** Called by UEnemyPathSubsystem with this enemy's copy of a shared path to Goal. */
+	void FollowPath(AActor* Goal, FNavPathSharedPtr Path);
+
+	/** Called by UEnemyCrowdSubsystem: with a slot this enemy paths to CombatTarget, without one it stops and holds. */
+	void SetCrowdAttackSlot(bool bHasSlot);
+
+	/** Called by USlashSignificanceSubsystem when this enemy moves to another detail bucket. */
+	void SetSignificance(ESignificanceBucket Bucket);
+
+	/** Combat, attack and patrol radii for Slash.Debug.AIRanges; drawn every frame by UEnemyAIDirector. */
+	void DrawDebugRanges() const;
 
 	/** Combat */
 	void StartAttackTimer();
@@ -60,6 +85,10 @@ protected:
 
 	/** AActor */
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** ACharacter */
+	virtual void OnMovementModeChanged(EMovementMode PrevMovementMode, uint8 PreviousCustomMode = 0) override;
 
 	/** BaseCharacter */
 	virtual bool CanAttack() override;
@@ -68,19 +97,47 @@ protected:
 	virtual void AttackEnd() override;
 	virtual void HandleDamage(float DamageAmount) override;
 
-	UFUNCTION()
-		void PawnSeen(APawn* SeenPawn); // Callback for OnPawnSeen in UPawnSensingComponent
-
 private:
 	void InitializeEnemy();
 	void SpawnDefaultWeapon();
 	/** AI Behaviour */
-	void CheckPatrolTarget();
-	void CheckCombatTarget();
+	EEnemyRangeFlags ComputeRangeFlags();
+	void ApplyStateActions(EEnemyActions Actions);
+	void SetEnemyState(EEnemyState NewState);
+	void UpdateAnimationBudget();
+
+	/** Swaps between full character movement and navmesh walking per Slash.AI.LightweightMovement. */
+	void UpdateMovementMode();
+	void SetLightweightMovement(bool bLightweight);
+
+	/** Last bucket from USlashSignificanceSubsystem, fed to the animation budget allocator. */
+	ESignificanceBucket SignificanceBucket;
+
+	UPROPERTY()
+		class UEnemyAIDirector* AIDirector;
+
+	UPROPERTY()
+		class UEnemyPerceptionSubsystem* Perception;
+
+	int32 AIDirectorHandle = INDEX_NONE;
+	int32 PerceptionHandle = INDEX_NONE;
 
 	/** Combat */
-	UPROPERTY(VisibleAnywhere)
-		class UHealthBarComponent* HealthBarWidget;
+	UPROPERTY()
+		class UHealthBarSubsystem* HealthBars;
+
+	int32 HealthBarHandle = INDEX_NONE;
+
+	/** Height of the shared-layer health bar above the top of the capsule. */
+	UPROPERTY(EditAnywhere, Category = Combat)
+		float HealthBarHeight = 30.f;
+
+	/** Widget whose progress bar colours the shared-layer health bars, and the bar size in screen units. */
+	UPROPERTY(EditDefaultsOnly, Category = Combat)
+		TSubclassOf<class UHealthBar> HealthBarWidgetClass;
+
+	UPROPERTY(EditDefaultsOnly, Category = Combat)
+		FVector2D HealthBarSize = FVector2D(80.f, 8.f);
 
 	UPROPERTY(EditAnywhere)
 		TSubclassOf<class AWeapon> WeaponClass;
@@ -114,9 +171,25 @@ private:
 	UPROPERTY(EditInstanceOnly, Category = "AI Navigation")
 		AActor* PatrolTarget;
 
+	/** Authoring data only: baked into a shared UPatrolRouteSubsystem route at BeginPlay and then emptied. */
 	UPROPERTY(EditInstanceOnly, Category = "AI Navigation")
 		TArray<AActor*> PatrolTargets;
 
+	UPROPERTY()
+		class UPatrolRouteSubsystem* PatrolRoutes;
+
+	UPROPERTY()
+		class UEnemyPathSubsystem* PathRequests;
+
+	UPROPERTY()
+		class UEnemyCrowdSubsystem* Crowd;
+
+	int32 PatrolRoute = INDEX_NONE;
+
+	/** PatrolTarget's slot on PatrolRoute. */
+	int32 PatrolSlot = INDEX_NONE;
+	void BakePatrolRoute();
+
 	UPROPERTY(EditAnywhere, Category = "AI Navigation")
 		double PatrolRadius = 200.f;
 
@@ -141,5 +214,10 @@ private:
 
 	void ClearPatrolTimer();
 	
-	
+public:
+	FORCEINLINE EEnemyState GetEnemyState() const { return EnemyState; }
+	FORCEINLINE int32 GetAIDirectorHandle() const { return AIDirectorHandle; }
+	FORCEINLINE void SetAIDirectorHandle(int32 Handle) { AIDirectorHandle = Handle; }
+	FORCEINLINE int32 GetPerceptionHandle() const { return PerceptionHandle; }
+	FORCEINLINE void SetPerceptionHandle(int32 Handle) { PerceptionHandle = Handle; }
 };
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Characters/CharacterTypes.h"
+#include "Enemy/EnemyRangeKernel.h"
+#include "EnemyAIDirector.generated.h"
+
+class AEnemy;
+
+/**
+ * Owns every live AEnemy in the world and drives their AI from one batched tick
+ * instead of a virtual AActor::Tick per enemy. Per-enemy data is kept in parallel
+ * arrays indexed by the handle stored on the enemy.
+ */
+UCLASS()
+class SLASH_API UEnemyAIDirector : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** Called by AEnemy whenever its EEnemyState changes so the director can re-prioritize it. */
+	void NotifyStateChanged(const AEnemy* Enemy, EEnemyState NewState);
+
+	/** Called by UBudgetedSkeletalMeshComponent after each full pose evaluation of an enemy mesh in this world. */
+	void ReportMeshEvaluation(float Ms);
+
+	FORCEINLINE int32 GetNumEnemies() const { return Enemies.Num(); }
+
+private:
+	float GetUpdateInterval(int32 Index, const TArray<FVector>& ViewerLocations) const;
+	void GatherViewerLocations(TArray<FVector>& OutLocations) const;
+	void UpdateEnemy(int32 Index, EEnemyRangeFlags RangeFlags);
+	void UpdateAnimationBudgetStats() const;
+
+	/** Parallel arrays, one slot per registered enemy. */
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	TArray<FVector> CachedLocations;
+	TArray<EEnemyState> States;
+	TArray<double> NextUpdateTimes;
+
+	/** Running average game-thread cost of a full enemy mesh evaluation, for the skipped-frame savings stat. */
+	float AverageMeshEvaluationMs = 0.f;
+
+	/** Round-robin start index for the next tick's budgeted pass. */
+	int32 Cursor = 0;
+
+	/** Per-frame scratch, kept around so the steady state doesn't allocate. */
+	TArray<int32> DueIndices;
+	FEnemyRangeBatch RangeBatch;
+};
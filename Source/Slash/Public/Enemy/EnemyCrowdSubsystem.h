@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Spatial/SpatialHashGrid.h"
+#include "EnemyCrowdSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Optional crowd mode for enemies in combat (Slash.AI.Crowd). Only the Slash.AI.AttackSlots
+ * enemies nearest each target hold an attack slot and path to it. The others stop path
+ * following and steer towards a ring of Slash.AI.HoldRingRadius around the target, kept apart
+ * by separation from their neighbours. Neighbour queries go through a shared spatial hash grid
+ * and run in parallel; the game thread then only applies the resulting steering input.
+ */
+UCLASS()
+class SLASH_API UEnemyCrowdSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	/** Adds Enemy to the crowd around Target; returns whether it may path to Target (always true with the crowd off). */
+	bool AddChaser(AEnemy* Enemy, AActor* Target);
+	void RemoveChaser(AEnemy* Enemy);
+
+private:
+	void ReleaseAll();
+	void RemoveChaserAt(int32 Index);
+	void AssignAttackSlots();
+	void ComputeSteering();
+	int32 CountSlots(const AActor* Target) const;
+
+	/** Chasers, stored as parallel arrays. */
+	UPROPERTY()
+	TArray<AEnemy*> Chasers;
+
+	TArray<TWeakObjectPtr<AActor>> ChaseTargets;
+	TArray<bool> HasSlot;
+
+	/** Per-frame scratch, kept around so the steady state doesn't allocate. */
+	TArray<FVector> Locations;
+	TArray<FVector> TargetLocations;
+	TArray<FVector> Steering;
+	TArray<int32> SlotOrder;
+	FSpatialHashGrid Grid;
+};
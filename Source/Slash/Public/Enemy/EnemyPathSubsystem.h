@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Containers/RingBuffer.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyPathSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Queue for enemy movement requests. Requests are grouped by goal actor and by the coarse
+ * grid cell the enemy starts in (Slash.AI.PathShareCellSize), and each group is served by
+ * one async navmesh query from the member nearest the group's centre, at most
+ * Slash.AI.MaxPathfindsPerFrame per frame. A member within Slash.AI.PathShareRadius of the query
+ * start whose connector onto the path is clear on the navmesh follows its own copy of the
+ * shared path; any other member gets a query of its own. Groups re-path only once their goal has
+ * moved more than the acceptance radius from where it was pathed to, so a hundred enemies
+ * chasing one player cost a few queries instead of one each.
+ */
+UCLASS()
+class SLASH_API UEnemyPathSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	/** Moves Enemy to Goal through the shared queue; replaces any move it was already making. */
+	void RequestMove(AEnemy* Enemy, AActor* Goal, float AcceptanceRadius);
+	void CancelMove(AEnemy* Enemy);
+
+private:
+	struct FPathKey
+	{
+		TObjectKey<AActor> Goal;
+		FIntPoint Cell;
+
+		bool operator==(const FPathKey& Other) const { return Goal == Other.Goal && Cell == Other.Cell; }
+		friend uint32 GetTypeHash(const FPathKey& Key) { return HashCombineFast(GetTypeHash(Key.Goal), GetTypeHash(Key.Cell)); }
+	};
+
+	struct FPathGroup
+	{
+		TWeakObjectPtr<AActor> Goal;
+		TArray<TWeakObjectPtr<AEnemy>> Members;
+
+		/** Smallest acceptance radius among members; also the re-path threshold. */
+		float AcceptanceRadius = 0.f;
+
+		FVector StartLocation = FVector::ZeroVector;
+		FVector PathedGoalLocation = FVector::ZeroVector;
+		TArray<FVector> PathPoints;
+		uint32 QueryId = 0;
+		bool bQueued = false;
+		bool bPathed = false;
+	};
+
+	/** A member whose connector onto its group's path isn't safe to share paths on its own. */
+	struct FSoloRequest
+	{
+		TWeakObjectPtr<AEnemy> Enemy;
+		TWeakObjectPtr<AActor> Goal;
+	};
+
+	void Enqueue(const FPathKey& Key, FPathGroup& Group);
+	void EnqueueSolo(AEnemy* Enemy, AActor* Goal);
+	void IssueQuery(const FPathKey& Key, FPathGroup& Group);
+	bool IssueSoloQuery(AEnemy* Enemy, AActor* Goal);
+	uint32 FindPathAsync(AEnemy* Querier, const FVector& Start, const FVector& End);
+	void OnPathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+	void ApplyPath(AEnemy* Enemy, const FPathGroup& Group);
+	bool CanSharePath(const AEnemy* Enemy, const FPathGroup& Group) const;
+	AEnemy* PickRepresentative(const FPathGroup& Group) const;
+	bool IsMemberHeadingFor(const AEnemy* Enemy, const AActor* Goal) const;
+	void RemoveMember(AEnemy* Enemy);
+
+	TMap<FPathKey, FPathGroup> Groups;
+	TMap<TObjectKey<AEnemy>, FPathKey> MemberGroups;
+	TRingBuffer<FPathKey> Queue;
+	TMap<uint32, FPathKey> PendingQueries;
+
+	/** Each queued enemy appears once; SoloGoals holds the goal of its latest request. */
+	TRingBuffer<TObjectKey<AEnemy>> SoloQueue;
+	TMap<TObjectKey<AEnemy>, TWeakObjectPtr<AActor>> SoloGoals;
+	TMap<uint32, FSoloRequest> SoloQueries;
+};
@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Spatial/SpatialHashGrid.h"
+#include "WorldCollision.h"
+#include "EnemyPerceptionSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Replaces per-enemy UPawnSensingComponent polling. Engageable pawns are indexed in a shared
+ * spatial hash grid and every sensing enemy is resolved against it in one pass: grid radius
+ * query, then peripheral cone test, and only then a line-of-sight trace. Traces are issued
+ * asynchronously and consumed on the following frame, where visible pawns are reported
+ * through AEnemy::PawnSeen exactly like OnSeePawn was.
+ */
+UCLASS()
+class SLASH_API UEnemyPerceptionSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void RegisterSensor(AEnemy* Enemy, float SightRadius, float PeripheralVisionAngle);
+	void UnregisterSensor(AEnemy* Enemy);
+
+	void RegisterTarget(APawn* Pawn);
+	void UnregisterTarget(APawn* Pawn);
+
+private:
+	void RunSensingPass();
+	void GatherTargets();
+	void SubmitSightTrace(const FVector& EyeLocation, AEnemy* Sensor, APawn* Target, const FVector& TargetLocation);
+	void ConsumeSightTraces();
+
+	struct FPendingSightTrace
+	{
+		FTraceHandle Handle;
+		TWeakObjectPtr<AEnemy> Sensor;
+		TWeakObjectPtr<APawn> Target;
+		double SubmitTime;
+	};
+	TArray<FPendingSightTrace> PendingTraces;
+
+	/** Sensors, stored as parallel arrays. */
+	UPROPERTY()
+	TArray<AEnemy*> Sensors;
+
+	TArray<float> SightRadii;
+	TArray<float> CosPeripheralVisionAngles;
+	float MaxSightRadius = 0.f;
+
+	UPROPERTY()
+	TArray<APawn*> Targets;
+
+	/** Per-pass snapshot of the live targets the grid was built from. */
+	TArray<APawn*> PassTargets;
+	TArray<FVector> PassTargetLocations;
+	FSpatialHashGrid TargetGrid;
+
+	double NextSensingTime = 0.0;
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Per-enemy results of FEnemyRangeBatch::Compute. */
+enum class EEnemyRangeFlags : uint8
+{
+	None = 0,
+	InAttackRadius = 1 << 0,
+	InCombatRadius = 1 << 1,
+	InPatrolRadius = 1 << 2
+};
+ENUM_CLASS_FLAGS(EEnemyRangeFlags)
+
+/**
+ * Structure-of-arrays batch of enemy range queries. Every enemy contributes its location,
+ * its combat and patrol target locations and the squared radii to test them against;
+ * Compute() answers all of them in one SIMD pass without a square root.
+ *
+ * Positions are stored as float offsets from Origin so the 4-wide float kernel keeps
+ * its precision in large worlds.
+ */
+struct SLASH_API FEnemyRangeBatch
+{
+public:
+	void Reset(const FVector& InOrigin, int32 ExpectedNum = 0);
+
+	/** Adds one enemy. Pass nullptr for a missing target; its flag will never be set. */
+	int32 Add(const FVector& Location, const FVector* CombatTargetLocation, double AttackRadius, double CombatRadius, const FVector* PatrolTargetLocation, double PatrolRadius);
+
+	/** Vectorized kernel, fills Results. */
+	void Compute();
+
+	/** Scalar reference with the original sqrt-based comparison, used to validate and benchmark Compute(). */
+	void ComputeScalar();
+
+	FORCEINLINE int32 Num() const { return NumQueries; }
+	FORCEINLINE EEnemyRangeFlags GetFlags(int32 Index) const { return Results[Index]; }
+	FORCEINLINE const TArray<EEnemyRangeFlags>& GetResults() const { return Results; }
+
+private:
+	void PadToVectorWidth();
+	void TrimPadding();
+
+	FVector Origin = FVector::ZeroVector;
+	int32 NumQueries = 0;
+
+	TArray<float> LocationX, LocationY, LocationZ;
+	TArray<float> CombatTargetX, CombatTargetY, CombatTargetZ;
+	TArray<float> PatrolTargetX, PatrolTargetY, PatrolTargetZ;
+	TArray<float> AttackRadiusSquared, CombatRadiusSquared, PatrolRadiusSquared;
+
+	TArray<EEnemyRangeFlags> Results;
+};
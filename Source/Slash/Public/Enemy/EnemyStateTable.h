@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "Characters/CharacterTypes.h"
+#include "Enemy/EnemyRangeKernel.h"
+
+/** Side effects an AI update asks AEnemy to run. AEnemy::ApplyStateActions runs them in bit order. */
+enum class EEnemyActions : uint8
+{
+	None = 0,
+	ClearAttackTimer = 1 << 0,
+	LoseInterest = 1 << 1,
+	StartPatrolling = 1 << 2,
+	StartChasing = 1 << 3,
+	StartAttackTimer = 1 << 4,
+	PickPatrolTarget = 1 << 5
+};
+ENUM_CLASS_FLAGS(EEnemyActions)
+
+/**
+ * Enemy AI transitions as a table of EEnemyState x condition mask -> actions, built at compile time.
+ * The condition mask is the EEnemyRangeFlags the director's batched range kernel already produces,
+ * so an update is one indexed load instead of a chain of range predicates. Decide() is the single
+ * readable statement of the rules; it only ever runs inside the compiler.
+ */
+namespace EnemyStateTable
+{
+	constexpr int32 NumStates = static_cast<int32>(EEnemyState::EES_Engaged) + 1;
+	constexpr int32 NumConditionMasks = 1 << 3;
+
+	constexpr EEnemyActions Decide(EEnemyState State, EEnemyRangeFlags Conditions)
+	{
+		const bool bInAttackRadius = EnumHasAnyFlags(Conditions, EEnemyRangeFlags::InAttackRadius);
+		const bool bInCombatRadius = EnumHasAnyFlags(Conditions, EEnemyRangeFlags::InCombatRadius);
+		const bool bInPatrolRadius = EnumHasAnyFlags(Conditions, EEnemyRangeFlags::InPatrolRadius);
+
+		if (State == EEnemyState::EES_Dead) return EEnemyActions::None;
+
+		// Patrollers only care about reaching their patrol point; perception starts the chase
+		if (State == EEnemyState::EES_Patrolling)
+		{
+			return bInPatrolRadius ? EEnemyActions::PickPatrolTarget : EEnemyActions::None;
+		}
+
+		// Everyone else reacts to the combat target. Engaged enemies are mid-swing and leave the
+		// state change to AttackEnd, which evaluates the table again as Unoccupied.
+		const bool bEngaged = State == EEnemyState::EES_Engaged;
+		if (!bInCombatRadius)
+		{
+			return EEnemyActions::ClearAttackTimer | EEnemyActions::LoseInterest | (bEngaged ? EEnemyActions::None : EEnemyActions::StartPatrolling);
+		}
+		if (!bInAttackRadius)
+		{
+			if (State == EEnemyState::EES_Chasing) return EEnemyActions::None;
+			return EEnemyActions::ClearAttackTimer | (bEngaged ? EEnemyActions::None : EEnemyActions::StartChasing);
+		}
+		if (State != EEnemyState::EES_Attacking && !bEngaged)
+		{
+			return EEnemyActions::StartAttackTimer;
+		}
+		return EEnemyActions::None;
+	}
+
+	struct FTable
+	{
+		EEnemyActions Actions[NumStates][NumConditionMasks];
+	};
+
+	constexpr FTable Build()
+	{
+		FTable Table{};
+		for (int32 State = 0; State < NumStates; ++State)
+		{
+			for (int32 Mask = 0; Mask < NumConditionMasks; ++Mask)
+			{
+				Table.Actions[State][Mask] = Decide(static_cast<EEnemyState>(State), static_cast<EEnemyRangeFlags>(Mask));
+			}
+		}
+		return Table;
+	}
+
+	inline constexpr FTable Table = Build();
+
+	FORCEINLINE constexpr EEnemyActions Lookup(EEnemyState State, EEnemyRangeFlags Conditions)
+	{
+		return Table.Actions[static_cast<uint8>(State)][static_cast<uint8>(Conditions) & (NumConditionMasks - 1)];
+	}
+}
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PatrolRouteSubsystem.generated.h"
+
+struct FSlashRng;
+
+/**
+ * Patrol routes baked from enemies' PatrolTargets as they begin play. Waypoint actors live once
+ * in a world-wide array and a route is a slice of waypoint indices. Enemies with the same set of
+ * patrol targets share one route and only keep its handle and their current slot, so picking the
+ * next waypoint is a single random index with no copies or allocation.
+ */
+UCLASS()
+class SLASH_API UPatrolRouteSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Returns the route visiting Waypoints (order and duplicates don't matter), baking it on first use. */
+	int32 RegisterRoute(TArrayView<AActor* const> Waypoints);
+
+	/** Slot of Waypoint on Route, or INDEX_NONE if the route doesn't visit it. */
+	int32 FindSlot(int32 Route, const AActor* Waypoint) const;
+
+	/** A uniformly chosen slot other than CurrentSlot (any slot when CurrentSlot is INDEX_NONE), or INDEX_NONE if there is none. */
+	int32 PickNextSlot(int32 Route, int32 CurrentSlot, FSlashRng& Rng) const;
+
+	AActor* GetWaypoint(int32 Route, int32 Slot) const;
+
+	void DumpStats() const;
+
+private:
+	int32 FindOrAddWaypoint(AActor* Waypoint);
+	int32 FindRoute(TArrayView<const int32> SortedWaypoints, uint32 Hash) const;
+
+	struct FPatrolRoute
+	{
+		/** Into RouteWaypoints; NumSlots entries. */
+		int32 FirstSlot = 0;
+		int32 NumSlots = 0;
+	};
+
+	UPROPERTY()
+	TArray<AActor*> Waypoints;
+
+	TMap<const AActor*, int32> WaypointIndices;
+
+	TArray<FPatrolRoute> Routes;
+	TArray<int32> RouteWaypoints;
+
+	/** Hash of a route's sorted waypoint indices -> route, to share identical routes. */
+	TMultiMap<uint32, int32> RouteLookup;
+};
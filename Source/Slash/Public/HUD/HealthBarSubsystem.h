@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HealthBarSubsystem.generated.h"
+
+class SHealthBarLayer;
+class UHealthBar;
+
+/** One bar to draw, already projected into the layer's local space. */
+struct FHealthBarDrawData
+{
+	FVector2f Position;
+	float Percent;
+};
+
+/** Size in layer units and colours that every bar is drawn with. */
+struct FHealthBarStyle
+{
+	FVector2D Size = FVector2D(80.f, 8.f);
+	FLinearColor FillColor = FLinearColor(0.8f, 0.05f, 0.05f);
+	FLinearColor BackgroundColor = FLinearColor(0.f, 0.f, 0.f, 0.6f);
+};
+
+/**
+ * Owns the single SHealthBarLayer in the game viewport and the bars it draws. Actors add a
+ * bar once and then only push percent and visibility changes; after the camera has updated
+ * each frame, visible bars within range are projected into one packed array for the layer.
+ * Replaces a UHealthBarComponent (widget tree plus render target) per enemy.
+ */
+UCLASS()
+class SLASH_API UHealthBarSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Adds a hidden, full bar floating HeightOffset above the actor's location. Returns its handle. */
+	int32 AddBar(AActor* Actor, float HeightOffset);
+	void RemoveBar(int32 Handle);
+
+	void SetBarPercent(int32 Handle, float Percent);
+	void SetBarVisible(int32 Handle, bool bVisible);
+
+	/**
+	 * Styles every bar after the progress bar in WidgetClass, drawn at Size. The layer draws all
+	 * bars in one style, so only the first call before the layer is created takes effect.
+	 */
+	void SetBarStyle(TSubclassOf<UHealthBar> WidgetClass, const FVector2D& Size);
+
+private:
+	void UpdateLayer(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	bool EnsureLayer();
+
+	struct FHealthBarEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		float HeightOffset = 0.f;
+		float Percent = 1.f;
+		bool bVisible = false;
+	};
+	TSparseArray<FHealthBarEntry> Bars;
+	int32 NumVisibleBars = 0;
+
+	/** Reused every frame and swapped into the layer. */
+	TArray<FHealthBarDrawData> DrawData;
+
+	FHealthBarStyle Style;
+	bool bStyleSet = false;
+
+	TSharedPtr<SHealthBarLayer> Layer;
+	FDelegateHandle PostActorTickHandle;
+};
@@ -6,14 +6,24 @@
 #include "Blueprint/UserWidget.h"
 #include "SlashOverlay.generated.h"
 
+class UAttributeComponent;
+
 /**
- * 
+ * Player HUD. The setters only record the latest value; everything set during a frame is
+ * coalesced and pushed to the bound widgets once, after actors have ticked, and only for
+ * values that actually changed. Untouched widgets are never invalidated, so the overlay
+ * isn't repainted on frames where nothing changed. Bound attributes publish their changes
+ * straight into it; regenerating stamina is sampled once per frame until the regen completes.
  */
 UCLASS()
 class SLASH_API USlashOverlay : public UUserWidget
 {
 	GENERATED_BODY()
 	
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeDestruct() override;
+
 private:
 	UPROPERTY(meta = (BindWidget))
 	class UProgressBar* HealthProgressBar;
@@ -27,8 +37,47 @@ private:
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* SoulsCountText;
 
+	enum EDirtyField : uint8
+	{
+		DF_Health = 1 << 0,
+		DF_Stamina = 1 << 1,
+		DF_Coins = 1 << 2,
+		DF_Souls = 1 << 3
+	};
+
+	void MarkDirty(EDirtyField Field);
+	void FlushPendingChanges(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void UnbindAttributes();
+	void HandleHealthChanged(float NewValue, float MaxValue);
+	void HandleStaminaChanged(float NewValue, float MaxValue);
+
+	TWeakObjectPtr<UAttributeComponent> BoundAttributes;
+	FDelegateHandle HealthChangedHandle;
+	FDelegateHandle StaminaChangedHandle;
+	FDelegateHandle GoldChangedHandle;
+	FDelegateHandle SoulsChangedHandle;
+
+	uint8 DirtyFields = 0;
+	FDelegateHandle FlushHandle;
+
+	/** Latest values set this frame. */
+	float PendingHealthPercent = 0.f;
+	float PendingStaminaPercent = 0.f;
+	int32 PendingCoins = 0;
+	int32 PendingSouls = 0;
+
+	/** Values currently shown, INDEX_NONE / negative until first pushed. */
+	float ShownHealthPercent = -1.f;
+	float ShownStaminaPercent = -1.f;
+	int32 ShownCoins = INDEX_NONE;
+	int32 ShownSouls = INDEX_NONE;
+
 public:
 
+	/** Pushes the component's current values and follows its change delegates from now on. */
+	void BindAttributes(UAttributeComponent* InAttributes);
+
 	void SetHealthBarPercent(float percent);
 	void SetStaminaBarPercent(float percent);
 	FText IntToFText(const int32& count);
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI)
+class UPoolableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Reset hooks for actors handed out by UActorPoolSubsystem. BeginPlay only runs for the
+ * first spawn, so anything it sets up per use belongs in OnAcquiredFromPool as well.
+ */
+class SLASH_API IPoolableInterface
+{
+	GENERATED_BODY()
+
+public:
+	/** Called after the pool has moved, shown and re-enabled the actor for another use. */
+	virtual void OnAcquiredFromPool();
+
+	/** Called before the pool hides the actor and disables its collision and tick. */
+	virtual void OnReturnedToPool();
+};
@@ -4,9 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Interfaces/PoolableInterface.h"
 #include "Item.generated.h"
 
 class USphereComponent;
+class UItemAnimationSubsystem;
+enum class ESignificanceBucket : uint8;
 
 UENUM(BlueprintType)
 enum class EItemState : uint8
@@ -18,16 +21,28 @@ enum class EItemState : uint8
 
 
 UCLASS()
-class SLASH_API AItem : public AActor
+class SLASH_API AItem : public AActor, public IPoolableInterface
 {
 	GENERATED_BODY()
 	
 public:	
 	AItem();
-	virtual void Tick(float DeltaTime) override;
+
+	/** IPoolableInterface */
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReturnedToPool() override;
+
+	/** Called by USlashSignificanceSubsystem while the item is hovering. */
+	void SetSignificance(ESignificanceBucket Bucket);
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/** Hover motion is driven by UItemAnimationSubsystem while the item is EIS_Hovering. */
+	void StartHovering();
+	void StopHovering();
+	void SetHoverDescent(float TargetZ, float Speed);
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sine Parameters")
 	float Amplitude = 0.25f;
@@ -75,7 +90,15 @@ private:
 	UPROPERTY(VisibleAnyWhere, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	float RunningTime;
 
-	
+	UPROPERTY()
+	UItemAnimationSubsystem* ItemAnimation;
+
+	int32 AnimationHandle = INDEX_NONE;
+
+public:
+	FORCEINLINE int32 GetAnimationHandle() const { return AnimationHandle; }
+	FORCEINLINE void SetAnimationHandle(int32 Handle) { AnimationHandle = Handle; }
+	FORCEINLINE void SetRunningTime(float Time) { RunningTime = Time; }
 };
 
 template<typename T>
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemAnimationSubsystem.generated.h"
+
+class AItem;
+
+/**
+ * Drives the hover bob and spin of every hovering AItem in one pass instead of a Tick per item.
+ * The sine terms for all items are evaluated four at a time, and each item then gets a single
+ * SetActorLocationAndRotation instead of separate offset and rotation updates. The bob is set
+ * absolutely from each item's rest height, so items that aren't on screen only advance their phase. Per-item data lives in parallel arrays indexed by
+ * the handle stored on the item.
+ */
+UCLASS()
+class SLASH_API UItemAnimationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void RegisterItem(AItem* Item, float RunningTime, float Amplitude, float TimeConstant, float ForwardSpeed);
+	void UnregisterItem(AItem* Item);
+
+	/** Makes the item sink at Speed units per second until it reaches TargetZ. */
+	void SetDescent(const AItem* Item, float TargetZ, float Speed);
+
+	FORCEINLINE int32 GetNumItems() const { return Items.Num() - PendingRemovals.Num(); }
+
+private:
+	void RemoveAt(int32 Index);
+
+	/** Parallel arrays, one slot per registered item. */
+	UPROPERTY()
+	TArray<AItem*> Items;
+
+	TArray<float> RunningTimes;
+	TArray<float> TimeConstants;
+	TArray<float> Amplitudes;
+
+	/** Height the bob is centred on, captured at registration and lowered by any descent. */
+	TArray<double> RestZs;
+	TArray<float> ForwardSpeeds;
+	TArray<float> DescentTargets;
+	TArray<float> DescentSpeeds;
+
+	/** Moving an item can fire a pickup overlap that unregisters it, so removals wait for the pass to end. */
+	bool bAnimating = false;
+	TArray<AItem*> PendingRemovals;
+
+	/** Per-frame scratch, padded to the vector width. */
+	TArray<float> Phases;
+	TArray<float> Sines;
+};
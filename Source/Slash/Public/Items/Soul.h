@@ -16,13 +16,13 @@ class SLASH_API ASoul : public AItem
 
 public:
 	ASoul();
-	virtual void Tick(float DeltaTime) override;
 
-	void MoveToDesiredZ(float DeltaTime);
+	virtual void OnAcquiredFromPool() override;
 
 protected:
 	virtual void BeginPlay() override;
 	void BoxTrace(FHitResult& BoxHit);
+	void UpdateDesiredZ();
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
 	
 
@@ -33,6 +33,10 @@ private:
 	
 	float DesiredZ = 50.f;
 
+	/** Units per second the soul sinks until it hovers DesiredZ above the ground. */
+	UPROPERTY(EditAnywhere, Category = "Soul Properties")
+	float DescentSpeed = 15.f;
+
 public:
 	FORCEINLINE int32 GetSouls() const { return Souls; }
 	FORCEINLINE void SetSouls(int32 NumberOfSouls) { Souls = NumberOfSouls; }
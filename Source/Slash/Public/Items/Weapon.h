@@ -21,21 +21,27 @@ class SLASH_API AWeapon : public AItem
 public:
 
 	AWeapon();
+	virtual void Tick(float DeltaTime) override;
+	virtual void PreInitializeComponents() override;
+
+	/** IPoolableInterface */
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReturnedToPool() override;
+
 	void Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator);
 	void DeactivateEmbers();
 	void DisableSphereCollision();
 	void PlayEquipSound();
 	void AttachMeshToSocket(USceneComponent* InParent, const FName& InSocketName);
 
-	TArray<AActor*> IgnoreActors;
+	/** Active hit window, opened and closed together with the weapon box collision. */
+	void BeginSwing();
+	void EndSwing();
 
 protected:
 	virtual void BeginPlay() override;
 
-	UFUNCTION()
-		void OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	void ExecuteGetHit(FHitResult& BoxHit);
+	void ExecuteGetHit(const FHitResult& BoxHit);
 
 	UPROPERTY(EditInstanceOnly)
 		ECharacterState CharacterStateWhenEquipped = ECharacterState::ECS_EquippedOneHandedWeapon;
@@ -62,11 +68,31 @@ private:
 	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
 		FVector BoxTraceExtent = FVector(5.f);
 	
-	UPROPERTY(EditAnywhere, Category = "Weapon Properties")
-		bool bShowBoxDebug = false;
+	/** Upper bound on interpolated blade poses swept between two frames. */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties", meta = (ClampMin = "1", ClampMax = "16"))
+		int32 MaxSweepSubsteps = 6;
+
+	/** Blade tip travel per sub-step; slow movement collapses to a single sweep. */
+	UPROPERTY(EditAnywhere, Category = "Weapon Properties", meta = (ClampMin = "1.0"))
+		float SubstepTipTravel = 25.f;
 
+	void PrepareForOwnerSpawn();
 	bool ActorIsSameType(AActor* OtherActor);
-	void BoxTrace(FHitResult& BoxHit);
+	void BoxTrace();
+	void SweepBladeSegment(UWorld* World, const FTransform& From, const FTransform& To);
+	void ProcessHit(const FHitResult& BoxHit);
+
+	/** Swing state, reused across swings so the per-frame sweep doesn't allocate. */
+	bool bSwingActive = false;
+	bool bHasPreviousBlade = false;
+	FTransform PreviousBladeTransform;
+	FTransform PreviousOwnerTransform;
+	FVector BladeLocalEnd;
+	FCollisionQueryParams SwingQueryParams;
+	FCollisionObjectQueryParams SwingObjectParams;
+	TArray<AActor*, TInlineAllocator<8>> SwingHitActors;
+	TArray<FHitResult> SweepHits;
+	TArray<FHitResult> SegmentHits;
 	
 
 public:
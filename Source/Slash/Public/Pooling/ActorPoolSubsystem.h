@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorPoolSubsystem.generated.h"
+
+USTRUCT()
+struct FActorPoolBucket
+{
+	GENERATED_BODY()
+
+	/** Dormant instances, hidden with collision and tick disabled. */
+	UPROPERTY()
+	TArray<AActor*> FreeActors;
+
+	/** Every instance this bucket has spawned, in or out of the pool. */
+	int32 NumSpawned = 0;
+
+	int32 Hits = 0;
+	int32 Misses = 0;
+};
+
+/**
+ * Per-class pools of dormant actors for things that are spawned and destroyed constantly
+ * during combat, such as souls and treasure. Acquire reuses a pooled instance when one is
+ * free and only spawns on a miss; Release parks the actor instead of destroying it.
+ * Actors implementing IPoolableInterface get reset hooks on both transitions.
+ */
+UCLASS()
+class SLASH_API UActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** Spawns dormant instances until at least Count of Class exist. Safe to call repeatedly. */
+	void Prewarm(UClass* Class, int32 Count);
+
+	/** Prewarms with the Slash.Pool.PrewarmCount default. */
+	void Prewarm(UClass* Class);
+
+	AActor* AcquireActor(UClass* Class, const FTransform& Transform, AActor* Owner = nullptr);
+
+	template<typename T>
+	T* Acquire(TSubclassOf<T> Class, const FVector& Location, const FRotator& Rotation, AActor* Owner = nullptr);
+
+	void Release(AActor* Actor);
+
+	/** Returns the actor to its world's pool, or destroys it if there is no pool to return to. */
+	static void ReleaseOrDestroy(AActor* Actor);
+
+	void DumpStats() const;
+
+private:
+	AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform, AActor* Owner, bool bDormant);
+	void Deactivate(AActor* Actor);
+
+	UPROPERTY()
+	TMap<UClass*, FActorPoolBucket> Buckets;
+
+public:
+	FORCEINLINE const TMap<UClass*, FActorPoolBucket>& GetBuckets() const { return Buckets; }
+};
+
+template<typename T>
+inline T* UActorPoolSubsystem::Acquire(TSubclassOf<T> Class, const FVector& Location, const FRotator& Rotation, AActor* Owner)
+{
+	return Cast<T>(AcquireActor(Class.Get(), FTransform(Rotation, Location), Owner));
+}
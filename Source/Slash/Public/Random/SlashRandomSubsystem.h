@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Random/SlashRng.h"
+#include "SlashRandomSubsystem.generated.h"
+
+/** Independent random streams, so e.g. extra loot rolls don't shift every later AI decision. */
+enum class ESlashRandomStream : uint8
+{
+	AI,
+	Loot,
+	Animation,
+	Num
+};
+
+/**
+ * Per-world random numbers for gameplay. Every stream is seeded from the world seed, which
+ * is Slash.Random.Seed (or -SlashSeed=) when set and the clock otherwise, so runs with the
+ * same seed make the same choices frame for frame. Streams are game-thread only; batched
+ * work on other threads takes its own generators from ForkStream() up front.
+ */
+UCLASS()
+class SLASH_API USlashRandomSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/** Reseeds every stream, e.g. for a benchmark that must not depend on what ran at world start. */
+	void Reseed(uint64 InWorldSeed);
+
+	FSlashRng& GetStream(ESlashRandomStream Stream);
+
+	/** Appends NumForks generators carved from Stream for use on worker threads, one per task. */
+	void ForkStream(ESlashRandomStream Stream, int32 NumForks, TArray<FSlashRng>& OutForks);
+
+	/** Stream of WorldContext's world; falls back to a shared game-thread generator outside a world. */
+	static FSlashRng& Get(const UObject* WorldContext, ESlashRandomStream Stream);
+
+private:
+	FSlashRng Streams[static_cast<int32>(ESlashRandomStream::Num)];
+	uint64 WorldSeed = 0;
+
+public:
+	FORCEINLINE uint64 GetWorldSeed() const { return WorldSeed; }
+};
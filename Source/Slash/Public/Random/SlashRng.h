@@ -0,0 +1,117 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * xoshiro128** generator: 16 bytes of state, a handful of ALU ops per draw and a 2^128 - 1 period.
+ * A generator isn't shared between threads; hand workers their own copy via Fork(), which jumps
+ * this one 2^64 draws ahead so every fork owns a non-overlapping subsequence.
+ */
+struct FSlashRng
+{
+	FSlashRng() { Seed(0); }
+	explicit FSlashRng(uint64 InSeed) { Seed(InSeed); }
+
+	/** Expands a 64-bit seed into the full state with splitmix64, as the xoshiro authors recommend. */
+	void Seed(uint64 InSeed)
+	{
+		uint64 SplitMix = InSeed;
+		const uint64 A = NextSplitMix(SplitMix);
+		const uint64 B = NextSplitMix(SplitMix);
+		State[0] = static_cast<uint32>(A);
+		State[1] = static_cast<uint32>(A >> 32);
+		State[2] = static_cast<uint32>(B);
+		State[3] = static_cast<uint32>(B >> 32);
+		if ((State[0] | State[1] | State[2] | State[3]) == 0)
+		{
+			State[0] = 1;
+		}
+	}
+
+	FORCEINLINE uint32 NextUInt32()
+	{
+		const uint32 Result = Rotl(State[1] * 5, 7) * 9;
+		const uint32 T = State[1] << 9;
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= T;
+		State[3] = Rotl(State[3], 11);
+		return Result;
+	}
+
+	/** Uniform in [0, 1). */
+	FORCEINLINE float FRand()
+	{
+		return (NextUInt32() >> 8) * (1.f / 16777216.f);
+	}
+
+	FORCEINLINE float FRandRange(float Min, float Max)
+	{
+		return Min + (Max - Min) * FRand();
+	}
+
+	/** Uniform in [Min, Max], matching FMath::RandRange(int32, int32). */
+	FORCEINLINE int32 RandRange(int32 Min, int32 Max)
+	{
+		if (Max <= Min) return Min;
+		const uint32 Range = static_cast<uint32>(Max - Min) + 1;
+		return Min + static_cast<int32>((static_cast<uint64>(NextUInt32()) * Range) >> 32);
+	}
+
+	/** Uniform in [0, Num), or 0 for an empty range, matching FRandomStream::RandHelper. */
+	FORCEINLINE int32 RandHelper(int32 Num)
+	{
+		return Num > 0 ? RandRange(0, Num - 1) : 0;
+	}
+
+	/** Returns a generator for another thread or batch and advances this one past its subsequence. */
+	FSlashRng Fork()
+	{
+		FSlashRng Child = *this;
+		Jump();
+		return Child;
+	}
+
+	/** Equivalent to 2^64 calls to NextUInt32. */
+	void Jump()
+	{
+		static constexpr uint32 JumpPolynomial[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+		uint32 Jumped[4] = { 0, 0, 0, 0 };
+		for (const uint32 Word : JumpPolynomial)
+		{
+			for (int32 Bit = 0; Bit < 32; ++Bit)
+			{
+				if (Word & (1u << Bit))
+				{
+					Jumped[0] ^= State[0];
+					Jumped[1] ^= State[1];
+					Jumped[2] ^= State[2];
+					Jumped[3] ^= State[3];
+				}
+				NextUInt32();
+			}
+		}
+		FMemory::Memcpy(State, Jumped, sizeof(State));
+	}
+
+private:
+	static FORCEINLINE uint32 Rotl(uint32 Value, int32 Shift)
+	{
+		return (Value << Shift) | (Value >> (32 - Shift));
+	}
+
+	static FORCEINLINE uint64 NextSplitMix(uint64& InOutState)
+	{
+		uint64 Z = (InOutState += 0x9e3779b97f4a7c15ull);
+		Z = (Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94d049bb133111ebull;
+		return Z ^ (Z >> 31);
+	}
+
+	uint32 State[4];
+};
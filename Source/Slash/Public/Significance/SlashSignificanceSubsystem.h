@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashSignificanceSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/** Coarse detail levels, from full rate to effectively asleep. */
+enum class ESignificanceBucket : uint8
+{
+	High,
+	Medium,
+	Low,
+	Culled,
+	Num
+};
+
+enum class ESignificanceCategory : uint8
+{
+	Enemy,
+	Item,
+	Groom,
+	Num
+};
+
+/**
+ * Distance- and visibility-based scalability for enemies, hovering items and grooms.
+ * Registered primitives are scored against the nearest player view every
+ * Slash.Significance.Interval seconds and sorted into buckets; owners are only notified when
+ * their bucket changes, and each category decides what to scale down (animation rate, widget
+ * redraws, Niagara effects, groom LOD).
+ *
+ * A custom subsystem rather than USignificanceManager because the latter's class is chosen in
+ * DefaultEngine.ini, which this project doesn't ship, and a fixed bucket set is all we need.
+ */
+UCLASS()
+class SLASH_API USlashSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** UTickableWorldSubsystem */
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual void Deinitialize() override;
+
+	void Register(UPrimitiveComponent* Component, ESignificanceCategory Category);
+	void Unregister(UPrimitiveComponent* Component);
+
+	void DumpBuckets() const;
+
+private:
+	void Evaluate();
+	ESignificanceBucket ScoreBucket(const UPrimitiveComponent* Component, const TArray<FVector, TInlineAllocator<4>>& ViewLocations) const;
+	void ApplyBucket(UPrimitiveComponent* Component, ESignificanceCategory Category, ESignificanceBucket Bucket);
+
+	/** Parallel arrays, one slot per registered primitive. */
+	UPROPERTY()
+	TArray<UPrimitiveComponent*> Components;
+
+	TArray<ESignificanceCategory> Categories;
+	TArray<ESignificanceBucket> Buckets;
+
+	double NextEvaluationTime = 0.0;
+};
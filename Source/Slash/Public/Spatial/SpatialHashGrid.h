@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform grid over a set of points, hashed on XY. Rebuilt wholesale from a packed array
+ * whenever the caller's data changes; queries return indices into that array.
+ */
+class SLASH_API FSpatialHashGrid
+{
+public:
+	explicit FSpatialHashGrid(float InCellSize = 1000.f);
+
+	void SetCellSize(float InCellSize);
+	void Build(TConstArrayView<FVector> InPoints);
+
+	/** Appends the index of every point within Radius of Center. */
+	template<typename AllocatorType>
+	void QueryRadius(const FVector& Center, float Radius, TArray<int32, AllocatorType>& OutIndices) const;
+
+	FORCEINLINE int32 Num() const { return Points.Num(); }
+	FORCEINLINE const FVector& GetPoint(int32 Index) const { return Points[Index]; }
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+private:
+	FORCEINLINE int32 ToCell(double Coordinate) const { return FMath::FloorToInt32(Coordinate * InvCellSize); }
+	FORCEINLINE static uint64 CellKey(int32 CellX, int32 CellY) { return (uint64(uint32(CellX)) << 32) | uint64(uint32(CellY)); }
+
+	template<typename AllocatorType>
+	FORCEINLINE void GatherCell(int32 Start, int32 Count, const FVector& Center, double RadiusSquared, TArray<int32, AllocatorType>& OutIndices) const
+	{
+		for (int32 Slot = Start; Slot < Start + Count; ++Slot)
+		{
+			const int32 PointIndex = SortedIndices[Slot];
+			if (FVector::DistSquared(Points[PointIndex], Center) <= RadiusSquared)
+			{
+				OutIndices.Add(PointIndex);
+			}
+		}
+	}
+
+	float CellSize;
+	float InvCellSize;
+
+	TArray<FVector> Points;
+
+	/** Point indices grouped by cell; CellRanges maps a cell key to its (start, count) slice. */
+	TArray<int32> SortedIndices;
+	TArray<uint64> PointKeys;
+	TMap<uint64, TPair<int32, int32>> CellRanges;
+};
+
+template<typename AllocatorType>
+void FSpatialHashGrid::QueryRadius(const FVector& Center, float Radius, TArray<int32, AllocatorType>& OutIndices) const
+{
+	if (Points.Num() == 0) return;
+
+	const double RadiusSquared = double(Radius) * Radius;
+	const int32 MinX = ToCell(Center.X - Radius);
+	const int32 MaxX = ToCell(Center.X + Radius);
+	const int32 MinY = ToCell(Center.Y - Radius);
+	const int32 MaxY = ToCell(Center.Y + Radius);
+
+	// Large radii over a sparse grid: walking the occupied cells is cheaper than probing every covered one
+	const int64 CoveredCells = int64(MaxX - MinX + 1) * int64(MaxY - MinY + 1);
+	if (CoveredCells > CellRanges.Num())
+	{
+		for (const TPair<uint64, TPair<int32, int32>>& Cell : CellRanges)
+		{
+			const int32 CellX = int32(Cell.Key >> 32);
+			const int32 CellY = int32(Cell.Key & 0xffffffff);
+			if (CellX >= MinX && CellX <= MaxX && CellY >= MinY && CellY <= MaxY)
+			{
+				GatherCell(Cell.Value.Key, Cell.Value.Value, Center, RadiusSquared, OutIndices);
+			}
+		}
+		return;
+	}
+
+	for (int32 CellX = MinX; CellX <= MaxX; ++CellX)
+	{
+		for (int32 CellY = MinY; CellY <= MaxY; ++CellY)
+		{
+			if (const TPair<int32, int32>* Range = CellRanges.Find(CellKey(CellX, CellY)))
+			{
+				GatherCell(Range->Key, Range->Value, Center, RadiusSquared, OutIndices);
+			}
+		}
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EngineDefines.h"
+#include "Debug/SlashDebugDrawSubsystem.h"
+
+/**
+ * Category-gated debug drawing through USlashDebugDrawSubsystem's batched line buffer.
+ * In Shipping and Test the macros expand to nothing, arguments included.
+ *
+ * SLASH_DRAW_BOX(this, Weapon, Center, Extent, Rotation, FColor::Red);
+ * SLASH_DRAW_ARROW(GetWorld(), HitReact, Start, End, FColor::Green, 5.f);
+ */
+#define SLASH_DEBUG_DRAW ENABLE_DRAW_DEBUG
+
+#if SLASH_DEBUG_DRAW
+#define SLASH_DEBUG_DRAW_CALL(WorldContext, Category, ...) \
+	do \
+	{ \
+		if (USlashDebugDrawSubsystem* SlashDebugDraw = USlashDebugDrawSubsystem::Get(WorldContext, ESlashDebugDraw::Category)) \
+		{ \
+			SlashDebugDraw->__VA_ARGS__; \
+		} \
+	} while (0)
+
+#define SLASH_DRAW_LINE(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddLine(__VA_ARGS__))
+#define SLASH_DRAW_ARROW(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddArrow(__VA_ARGS__))
+#define SLASH_DRAW_BOX(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddBox(__VA_ARGS__))
+#define SLASH_DRAW_CIRCLE(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddCircle(__VA_ARGS__))
+#define SLASH_DRAW_SPHERE(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddSphere(__VA_ARGS__))
+#define SLASH_DRAW_POINT(WorldContext, Category, ...) SLASH_DEBUG_DRAW_CALL(WorldContext, Category, AddPoint(__VA_ARGS__))
+#else
+#define SLASH_DRAW_LINE(...)
+#define SLASH_DRAW_ARROW(...)
+#define SLASH_DRAW_BOX(...)
+#define SLASH_DRAW_CIRCLE(...)
+#define SLASH_DRAW_SPHERE(...)
+#define SLASH_DRAW_POINT(...)
+#endif
@@ -0,0 +1,54 @@
+#include "SlashStats.h"
+
+UE_TRACE_CHANNEL_DEFINE(SlashChannel);
+
+bool FSlashScopeTimings::bCapturing = false;
+
+/** Innermost open FSlashScopeTimer on this thread. */
+static thread_local FSlashScopeTimer* GCurrentScopeTimer = nullptr;
+
+static TMap<FName, uint64>& GetScopeTotals()
+{
+	static TMap<FName, uint64> Totals;
+	return Totals;
+}
+
+void FSlashScopeTimings::BeginCapture()
+{
+	check(IsInGameThread());
+	GetScopeTotals().Reset();
+	bCapturing = true;
+}
+
+void FSlashScopeTimings::EndCapture()
+{
+	bCapturing = false;
+}
+
+void FSlashScopeTimings::Enter(FSlashScopeTimer& Timer)
+{
+	Timer.Parent = GCurrentScopeTimer;
+	GCurrentScopeTimer = &Timer;
+	Timer.StartCycles = FPlatformTime::Cycles64();
+}
+
+void FSlashScopeTimings::Exit(FSlashScopeTimer& Timer)
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - Timer.StartCycles;
+	GCurrentScopeTimer = Timer.Parent;
+	if (Timer.Parent)
+	{
+		Timer.Parent->ChildCycles += Cycles;
+	}
+
+	// Scopes are only placed on game-thread code; anything else would need a lock here
+	if (IsInGameThread())
+	{
+		GetScopeTotals().FindOrAdd(Timer.Scope) += Cycles - FMath::Min(Timer.ChildCycles, Cycles);
+	}
+}
+
+const TMap<FName, uint64>& FSlashScopeTimings::GetTotals()
+{
+	return GetScopeTotals();
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Slash"), STATGROUP_Slash, STATCAT_Advanced);
+
+/** Insights channel for gameplay scopes. Capture with -trace=cpu,slash (or Trace.Enable Slash). */
+UE_TRACE_CHANNEL_EXTERN(SlashChannel, SLASH_API);
+
+/** Times a scope into a STATGROUP_Slash cycle stat for `stat Slash` and as a CPU event on SlashChannel. */
+#define SLASH_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, SlashChannel)
+
+struct FSlashScopeTimer;
+
+/**
+ * Exclusive game-thread time per named scope, accumulated only while a capture is running so the
+ * headless benchmark can attribute frame time to subsystems without the stats system. Time spent
+ * in a nested scope (a pool acquire inside a perception pass, say) is charged to the inner scope
+ * only, so the totals add up to no more than the time spent in scopes.
+ */
+struct SLASH_API FSlashScopeTimings
+{
+	static void BeginCapture();
+	static void EndCapture();
+
+	/** Pushes and pops Timer on this thread's scope stack. */
+	static void Enter(FSlashScopeTimer& Timer);
+	static void Exit(FSlashScopeTimer& Timer);
+
+	/** Exclusive cycles per scope since the last BeginCapture. */
+	static const TMap<FName, uint64>& GetTotals();
+
+	static bool bCapturing;
+};
+
+struct FSlashScopeTimer
+{
+	explicit FSlashScopeTimer(FName InScope)
+		: Scope(InScope)
+	{
+		if (FSlashScopeTimings::bCapturing)
+		{
+			FSlashScopeTimings::Enter(*this);
+		}
+	}
+
+	~FSlashScopeTimer()
+	{
+		if (StartCycles != 0)
+		{
+			FSlashScopeTimings::Exit(*this);
+		}
+	}
+
+	FName Scope;
+	uint64 StartCycles = 0;
+
+	/** Inclusive cycles of the scopes nested directly inside this one. */
+	uint64 ChildCycles = 0;
+	FSlashScopeTimer* Parent = nullptr;
+};
+
+/** Benchmark timing for a named scope; also emitted on SlashChannel so captures line up with reports. */
+#define SLASH_SCOPE_TIMER(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("Slash." Name, SlashChannel); \
+	static const FName PREPROCESSOR_JOIN(SlashScopeName, __LINE__)(TEXT(Name)); \
+	FSlashScopeTimer PREPROCESSOR_JOIN(SlashScopeTimer, __LINE__)(PREPROCESSOR_JOIN(SlashScopeName, __LINE__))